@@ -0,0 +1,88 @@
+/**
+ * @file benchHelper.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+
+#include "game/Map.h"
+#include <benchmark/benchmark.h>
+
+namespace rc::bench {
+
+/// Viewport widths (screen columns, so rays per frame) used as benchmark parameter
+inline void viewportWidths(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("columns")->Arg(860)->Arg(1920)->Arg(3840);
+}
+
+/// Wall cell used in the generated maps
+constexpr game::mapCell wallCell{false, false, 2};
+/// Empty cell used in the generated maps
+constexpr game::mapCell voidCell{true, true, 0};
+
+/**
+ * @brief Build a square room with walls only on its border
+ * @param size Room's size in cells
+ * @return The map
+ */
+inline game::Map openRoom(game::Map::IndexType size) {
+    game::Map map(size, size);
+    auto& cells = map.getMapData();
+    for (size_t i = 1; i < size - 1u; ++i)
+        for (size_t j = 1; j < size - 1u; ++j)
+            cells[j * map.stride() + i] = voidCell;
+    map.updateDistanceField();
+    map.updateOccupancy();
+    return map;
+}
+
+/**
+ * @brief Build a map full of walls except a one-cell wide corridor along X
+ * @param size Map's size in cells
+ * @return The map
+ */
+inline game::Map longCorridor(game::Map::IndexType size) {
+    game::Map map(size, size);
+    auto& cells       = map.getMapData();
+    const size_t middle = size / 2u;
+    for (size_t i = 1; i < size - 1u; ++i)
+        cells[middle * map.stride() + i] = voidCell;
+    map.updateDistanceField();
+    map.updateOccupancy();
+    return map;
+}
+
+/**
+ * @brief Get the center of a cell in world coordinates
+ * @param map The map
+ * @param cell The cell
+ * @return World coordinate of the cell's center
+ */
+inline game::Map::worldCoordinates cellCenter(const game::Map& map, const game::Map::gridCoordinate& cell) {
+    return {(cell[0] + 0.5) * map.getCellSize(), (cell[1] + 0.5) * map.getCellSize()};
+}
+
+/**
+ * @brief Build the ray directions of one frame
+ * @param direction Central direction
+ * @param columns Amount of rays
+ * @param fov Field of view in degree
+ * @return The ray directions
+ */
+inline std::vector<game::Map::worldCoordinates> rayFan(const game::Map::worldCoordinates& direction, int64_t columns, double fov = 60.0) {
+    using Unit = math::geometry::Angle::Unit;
+    std::vector<game::Map::worldCoordinates> rays;
+    rays.reserve(static_cast<size_t>(columns));
+    const double increment = fov / static_cast<double>(columns);
+    auto ray               = direction.rotated({-fov / 2, Unit::Degree});
+    for (int64_t col = 0; col < columns; ++col) {
+        rays.push_back(ray);
+        ray.rotate({increment, Unit::Degree});
+    }
+    return rays;
+}
+
+}// namespace rc::bench
@@ -0,0 +1,55 @@
+/**
+ * @file engine_bench.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "benchHelper.h"
+#include "core/Engine.h"
+#include "graphics/image/TextureManager.h"
+#include "graphics/renderer/SoftwareRenderer.h"
+
+using Engine = rc::core::Engine;
+
+/**
+ * @brief Full frame on E1L1, rendered by the software renderer
+ * @param state Benchmark state
+ */
+static void BM_EngineFrame(benchmark::State& state) {
+    const auto columns = static_cast<int32_t>(state.range(0));
+    const auto rows    = columns * 550 / 860;
+    auto& engine       = Engine::get();
+    auto settings      = engine.getSettings();
+    settings.rendererType                      = rc::graphics::renderer::RendererType::Software;
+    settings.inputType                         = rc::core::input::InputType::Null;
+    settings.rendererSettings.ScreenResolution = {columns, rows};
+    settings.layout3D                          = {{0, 0}, {columns, rows}};
+    settings.drawTexture                       = true;
+    settings.drawMap                           = false;
+    settings.drawRays                          = false;
+    settings.rendererSettings.FrameLimit       = 1;
+    engine.setSettings(settings);
+    engine.init();
+    engine.mapLoad("E1L1");
+    engine.run();
+    auto* renderer = dynamic_cast<rc::graphics::renderer::SoftwareRenderer*>(engine.getRenderer());
+    if (renderer == nullptr || engine.getStatus() != Engine::Status::Running) {
+        state.SkipWithError("Unable to start the engine with the software renderer");
+        return;
+    }
+    // steady state: textures loaded, frame arena grown
+    for (int frame = 0; frame < 3; ++frame)
+        renderer->renderFrame();
+    double allocations = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        renderer->renderFrame();
+        allocations += static_cast<double>(engine.getFrameAllocations().m_allocationCalls);
+    }
+    state.counters["fps"]          = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    state.counters["allocs/frame"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+    state.counters["arena"]        = benchmark::Counter(static_cast<double>(engine.getFrameArena().capacity()), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    rc::graphics::image::TextureManager::get().unloadAll();
+}
+BENCHMARK(BM_EngineFrame)->Apply(rc::bench::viewportWidths)->Unit(benchmark::kMillisecond);
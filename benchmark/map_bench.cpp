@@ -0,0 +1,144 @@
+/**
+ * @file map_bench.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "benchHelper.h"
+#include "core/fs/DataFile.h"
+#include "game/World.h"
+#include "rayCastReference.h"
+#include <random>
+
+using Map = rc::game::Map;
+
+/// Ray casting kernels of the map
+enum class Kernel {
+    TwoPass,///< Former two pass implementation, one ray at a time
+    Dda,    ///< Map::castRay, one ray at a time
+};
+
+/**
+ * @brief Cast one frame of rays
+ * @param state Benchmark state
+ * @param kernel The ray casting kernel
+ * @param map The map
+ * @param from Starting point
+ * @param rays Ray directions
+ */
+static void castFrame(benchmark::State& state, Kernel kernel, const Map& map, const Map::worldCoordinates& from, const std::vector<Map::worldCoordinates>& rays) {
+    if (kernel == Kernel::Dda) {
+        for ([[maybe_unused]] auto _ : state) {
+            for (const auto& ray : rays)
+                benchmark::DoNotOptimize(map.castRay(from, ray));
+        }
+    } else {
+        for ([[maybe_unused]] auto _ : state) {
+            for (const auto& ray : rays)
+                benchmark::DoNotOptimize(rc::test::castRayTwoPass(map, from, ray));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rays.size()));
+}
+
+static void BM_CastRayOpenRoom(benchmark::State& state, Kernel kernel) {
+    const Map map  = rc::bench::openRoom(128);
+    const auto from = rc::bench::cellCenter(map, {64, 64});
+    castFrame(state, kernel, map, from, rc::bench::rayFan({1, 0.3}, state.range(0)));
+}
+BENCHMARK_CAPTURE(BM_CastRayOpenRoom, dda, Kernel::Dda)->Apply(rc::bench::viewportWidths);
+BENCHMARK_CAPTURE(BM_CastRayOpenRoom, twoPass, Kernel::TwoPass)->Apply(rc::bench::viewportWidths);
+
+static void BM_CastRayCorridor(benchmark::State& state, Kernel kernel) {
+    const Map map  = rc::bench::longCorridor(250);
+    const auto from = rc::bench::cellCenter(map, {1, 125});
+    castFrame(state, kernel, map, from, rc::bench::rayFan({1, 0}, state.range(0)));
+}
+BENCHMARK_CAPTURE(BM_CastRayCorridor, dda, Kernel::Dda)->Apply(rc::bench::viewportWidths);
+BENCHMARK_CAPTURE(BM_CastRayCorridor, twoPass, Kernel::TwoPass)->Apply(rc::bench::viewportWidths);
+
+static void BM_CastRayGrazing(benchmark::State& state, Kernel kernel) {
+    const Map map  = rc::bench::openRoom(128);
+    const auto from = rc::bench::cellCenter(map, {1, 1});
+    castFrame(state, kernel, map, from, rc::bench::rayFan({1, 0}, state.range(0), 1.0));
+}
+BENCHMARK_CAPTURE(BM_CastRayGrazing, dda, Kernel::Dda)->Apply(rc::bench::viewportWidths);
+BENCHMARK_CAPTURE(BM_CastRayGrazing, twoPass, Kernel::TwoPass)->Apply(rc::bench::viewportWidths);
+
+static void BM_CastRayArena(benchmark::State& state, Kernel kernel) {
+    // large open arena: the worst frame times, every ray crosses hundreds of empty cells
+    const auto size = static_cast<Map::IndexType>(state.range(1));
+    const Map map   = rc::bench::openRoom(size);
+    const auto from = rc::bench::cellCenter(map, {static_cast<Map::IndexType>(size / 2), static_cast<Map::IndexType>(size / 2)});
+    castFrame(state, kernel, map, from, rc::bench::rayFan({1, 0.3}, state.range(0)));
+}
+BENCHMARK_CAPTURE(BM_CastRayArena, dda, Kernel::Dda)->ArgNames({"columns", "size"})->ArgsProduct({{1920}, {256, 2048}});
+
+static void BM_CastRayE1L1(benchmark::State& state, Kernel kernel) {
+    Map map;
+    map.loadFromData("E1L1");
+    if (!map.isValid()) {
+        state.SkipWithError("Unable to load map E1L1");
+        return;
+    }
+    const auto [from, direction] = map.getPlayerStart();
+    castFrame(state, kernel, map, from, rc::bench::rayFan(direction, state.range(0)));
+}
+BENCHMARK_CAPTURE(BM_CastRayE1L1, dda, Kernel::Dda)->Apply(rc::bench::viewportWidths);
+BENCHMARK_CAPTURE(BM_CastRayE1L1, twoPass, Kernel::TwoPass)->Apply(rc::bench::viewportWidths);
+
+static void BM_WhichCell(benchmark::State& state) {
+    const Map map = rc::bench::openRoom(128);
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> dist{0.0, static_cast<double>(map.fullWidth())};
+    std::vector<Map::worldCoordinates> points(4096);
+    for (auto& point : points)
+        point = {dist(gen), dist(gen)};
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto& point : points)
+            benchmark::DoNotOptimize(map.whichCell(point));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_WhichCell);
+
+static void BM_MapLoad(benchmark::State& state) {
+    const auto format = static_cast<Map::FileFormat>(state.range(0));
+    Map map           = rc::bench::openRoom(static_cast<Map::IndexType>(state.range(1)));
+    map.saveToData("benchLoad", format);
+    for ([[maybe_unused]] auto _ : state) {
+        Map loaded;
+        loaded.loadFromData("benchLoad");
+        benchmark::DoNotOptimize(loaded.getMapData().getTexturePlane().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1) * state.range(1));
+    rc::core::fs::DataFile(format == Map::FileFormat::Binary ? "maps/benchLoad.rcmap" : "maps/benchLoad.map").remove();
+}
+BENCHMARK(BM_MapLoad)->ArgNames({"binary", "size"})->ArgsProduct({{0, 1}, {64, 512}})->Unit(benchmark::kMillisecond);
+
+static void BM_WorldCastRay(benchmark::State& state) {
+    // one frame of rays in a large room paged from its file, under a budget large enough for the chunks in view
+    Map map = rc::bench::openRoom(2048);
+    map.saveToData("benchWorld", Map::FileFormat::Binary);
+    rc::game::World world;
+    if (!world.openData("benchWorld")) {
+        state.SkipWithError("Unable to open the world");
+        return;
+    }
+    world.setMemoryBudget(size_t{8} << 20U);
+    const auto from = rc::bench::cellCenter(map, {1024, 1024});
+    const auto rays = rc::bench::rayFan({1, 0.3}, state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        world.update(from);
+        for (const auto& ray : rays)
+            benchmark::DoNotOptimize(world.castRay(from, ray));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rays.size()));
+    state.counters["residentKiB"] = static_cast<double>(world.getMemoryUsage()) / 1024.0;
+    state.counters["pageIns"]     = static_cast<double>(world.getPageIns());
+    world.close();
+    rc::core::fs::DataFile("maps/benchWorld.rcmap").remove();
+}
+BENCHMARK(BM_WorldCastRay)->Apply(rc::bench::viewportWidths);
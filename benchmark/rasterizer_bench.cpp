@@ -0,0 +1,77 @@
+/**
+ * @file rasterizer_bench.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "benchHelper.h"
+#include "graphics/Rasterizer.h"
+#include <cmath>
+
+using Texture = rc::graphics::image::Texture;
+
+static void BM_DrawDistantWalls(benchmark::State& state) {
+    // a frame of far walls (16 pixels high) sampling a 512x512 texture
+    Texture wall;
+    wall.loadFromFile("greystone.png");
+    if (state.range(0) != 0)
+        wall.buildMipmaps();
+    Texture view(1920, 1080);
+    constexpr double lineLength = 16.0;
+    const double lineY          = (1080.0 - lineLength) / 2.0;
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t col = 0; col < view.width(); ++col)
+            rc::graphics::drawWallColumn(view, col, lineY, lineLength, wall, static_cast<double>((col * 7) % wall.width()), 0, 1080, false);
+        benchmark::DoNotOptimize(view.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(view.width()));
+}
+BENCHMARK(BM_DrawDistantWalls)->ArgName("mipmaps")->Arg(0)->Arg(1);
+
+/**
+ * @brief Wall column stepped in double, as drawWallColumn did before the fixed point WallSpan
+ * @param target The frame buffer
+ * @param column Column of the frame buffer
+ * @param lineY Row of the wall's top
+ * @param lineLength Height of the wall
+ * @param tex Wall's texture
+ * @param texX Column in the wall's texture
+ */
+static void drawWallColumnDouble(Texture& target, size_t column, double lineY, double lineLength, const Texture& tex, double texX) {
+    const double textureIncrement = static_cast<double>(tex.height()) / lineLength;
+    const double beginCoord       = std::max(lineY, 0.0);
+    const double endCoord         = std::min(lineY + lineLength, static_cast<double>(target.height()));
+    const double beginTex         = std::max(0.0, -lineY * textureIncrement);
+    const auto maxTex             = static_cast<int32_t>(tex.height()) - 1;
+    const auto count              = static_cast<size_t>(std::ceil(endCoord - beginCoord));
+    const auto* source            = tex.data() + tex.pixelIndex(static_cast<size_t>(texX), 0);
+    auto* dest                    = target.data() + target.pixelIndex(column, static_cast<size_t>(beginCoord));
+    for (size_t pixel = 0; pixel < count; ++pixel, dest += target.columnStride()) {
+        const int32_t inc = std::min(static_cast<int32_t>(beginTex + static_cast<double>(pixel) * textureIncrement), maxTex);
+        *dest             = source[static_cast<size_t>(inc) * tex.columnStride()];
+    }
+}
+
+static void BM_DrawCloseWalls(benchmark::State& state) {
+    // a frame of walls close to the camera: twice the screen's height, clipped
+    Texture wall;
+    wall.loadFromFile("bluestone.png");
+    Texture view(1920, 1080);
+    constexpr double lineLength = 2160.0;
+    constexpr double lineY      = (1080.0 - lineLength) / 2.0;
+    const bool fixedPoint       = state.range(0) != 0;
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t col = 0; col < view.width(); ++col) {
+            const auto texX = static_cast<double>((col * 7) % wall.width());
+            if (fixedPoint)
+                rc::graphics::drawWallColumn(view, col, lineY, lineLength, wall, texX, 0, 1080, false);
+            else
+                drawWallColumnDouble(view, col, lineY, lineLength, wall, texX);
+        }
+        benchmark::DoNotOptimize(view.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(view.width() * view.height()));
+}
+BENCHMARK(BM_DrawCloseWalls)->ArgName("fixedPoint")->Arg(0)->Arg(1);
@@ -0,0 +1,99 @@
+/**
+ * @file texture_bench.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "benchHelper.h"
+#include "graphics/Pixels.h"
+#include "graphics/image/TextureManager.h"
+#include <chrono>
+
+using Texture        = rc::graphics::image::Texture;
+using TextureManager = rc::graphics::image::TextureManager;
+
+static void BM_TextureReadPNG(benchmark::State& state) {
+    for ([[maybe_unused]] auto _ : state) {
+        Texture tex;
+        tex.loadFromFile("bluestone.png");
+        benchmark::DoNotOptimize(tex.width());
+    }
+}
+BENCHMARK(BM_TextureReadPNG);
+
+static void BM_TextureManagerGetTexture(benchmark::State& state) {
+    auto& texMng = TextureManager::get();
+    // one lookup per screen column, as in a frame, with all wall textures already loaded
+    std::vector<std::string> names;
+    for (uint8_t id = 0; id < 8; ++id)
+        names.push_back(rc::game::mapCell{false, false, id}.getTextureName());
+    for (const auto& name : names)
+        texMng.getTexture(name);
+    const auto columns = static_cast<size_t>(state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t col = 0; col < columns; ++col)
+            benchmark::DoNotOptimize(texMng.getTexture(names[(col / 64) % names.size()]).width());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    texMng.unloadAll();
+}
+BENCHMARK(BM_TextureManagerGetTexture)->Apply(rc::bench::viewportWidths);
+
+static void BM_TextureManagerGetTextureHandle(benchmark::State& state) {
+    auto& texMng = TextureManager::get();
+    // same lookups, through handles resolved once
+    std::vector<rc::graphics::image::TextureHandle> handles;
+    for (uint8_t id = 0; id < 8; ++id)
+        handles.push_back(texMng.getHandle(rc::game::mapCell{false, false, id}.getTextureName()));
+    for (const auto& handle : handles)
+        texMng.getTexture(handle);
+    const auto columns = static_cast<size_t>(state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+        texMng.newFrame();
+        for (size_t col = 0; col < columns; ++col)
+            benchmark::DoNotOptimize(texMng.getTexture(handles[(col / 64) % handles.size()]).width());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    texMng.unloadAll();
+}
+BENCHMARK(BM_TextureManagerGetTextureHandle)->Apply(rc::bench::viewportWidths);
+
+static void BM_TextureManagerFirstFrame(benchmark::State& state) {
+    auto& texMng = TextureManager::get();
+    texMng.setLoaderThreads(static_cast<size_t>(state.range(0)));
+    std::vector<rc::graphics::image::TextureHandle> handles;
+    for (uint8_t id = 0; id < 8; ++id)
+        handles.push_back(texMng.getHandle(rc::game::mapCell{false, false, id}.getTextureName()));
+    // time of the frame drawing the walls for the first time: decoding or placeholders
+    for ([[maybe_unused]] auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        texMng.newFrame();
+        for (const auto& handle : handles)
+            benchmark::DoNotOptimize(texMng.getTexture(handle).width());
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        texMng.waitForLoads();
+        texMng.unloadAll();
+    }
+    texMng.setLoaderThreads(0);
+}
+BENCHMARK(BM_TextureManagerFirstFrame)->ArgName("loaderThreads")->Arg(0)->Arg(2)->UseManualTime()->Iterations(50);
+
+static void BM_DarkenPixels(benchmark::State& state) {
+    // shading a 512x512 texture, pixel by pixel or with the bulk kernel
+    Texture tex;
+    tex.loadFromFile("greystone.png");
+    std::vector<rc::graphics::Color> shaded(tex.width() * tex.height());
+    const std::span<const rc::graphics::Color> pixels(tex.data(), shaded.size());
+    const bool kernel = state.range(0) != 0;
+    for ([[maybe_unused]] auto _ : state) {
+        if (kernel)
+            rc::graphics::darkenPixels(pixels, shaded);
+        else
+            std::transform(pixels.begin(), pixels.end(), shaded.begin(), [](const rc::graphics::Color& color) { return color.darker(); });
+        benchmark::DoNotOptimize(shaded.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(shaded.size()));
+}
+BENCHMARK(BM_DarkenPixels)->ArgName("kernel")->Arg(0)->Arg(1);
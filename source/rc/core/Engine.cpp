@@ -8,17 +8,47 @@
 
 #include "Engine.h"
 #include "core/fs/DataFile.h"
+#include "game/Grid.h"
+#include "graphics/Rasterizer.h"
 #include "graphics/image/TextureManager.h"
 #include "graphics/renderer/NullRenderer.h"
 #include "graphics/renderer/OpenGlRenderer.h"
+#include "graphics/renderer/SoftwareRenderer.h"
 #include "input/GlInput.h"
+#include "input/NullInput.h"
 #include "tool/Tracker.h"
 
+#include <array>
+#include <charconv>
 #include <execution>
 #include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace rc::core {
 
+namespace {
+
+/**
+ * @brief Append a number to a text, formatted like an output stream would (no heap allocation)
+ * @tparam T Number's type
+ * @param text The text
+ * @param value The number
+ */
+template<typename T>
+void appendNumber(std::pmr::string& text, T value) {
+    std::array<char, 32> buffer{};
+    std::to_chars_result result;
+    if constexpr (std::is_floating_point_v<T>)
+        result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::general, 6);
+    else
+        result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    text.append(buffer.data(), result.ptr);
+}
+
+}// namespace
+
 void EngineSettings::fromJson(const nlohmann::json& data) {
     if (data.contains("rendererType"))
         rendererType = data["rendererType"];
@@ -38,6 +68,20 @@ void EngineSettings::fromJson(const nlohmann::json& data) {
         drawMap = data["drawMap"];
     if (data.contains("drawRays"))
         drawRays = data["drawRays"];
+    if (data.contains("compositeView"))
+        compositeView = data["compositeView"];
+    if (data.contains("shadedTextures"))
+        shadedTextures = data["shadedTextures"];
+    if (data.contains("mipmaps"))
+        mipmaps = data["mipmaps"];
+    if (data.contains("loaderThreads"))
+        loaderThreads = data["loaderThreads"];
+    if (data.contains("fov"))
+        fov = data["fov"];
+    if (data.contains("allocationSites"))
+        allocationSites = data["allocationSites"];
+    if (data.contains("pagedLevelCells"))
+        pagedLevelCells = data["pagedLevelCells"];
 }
 
 nlohmann::json EngineSettings::toJson() const {
@@ -51,6 +95,13 @@ nlohmann::json EngineSettings::toJson() const {
     data["drawTexture"]      = drawTexture;
     data["drawMap"]          = drawMap;
     data["drawRays"]         = drawRays;
+    data["compositeView"]    = compositeView;
+    data["shadedTextures"]   = shadedTextures;
+    data["mipmaps"]          = mipmaps;
+    data["loaderThreads"]    = loaderThreads;
+    data["fov"]              = fov;
+    data["allocationSites"]  = allocationSites;
+    data["pagedLevelCells"]  = pagedLevelCells;
     return data;
 }
 
@@ -73,6 +124,9 @@ void Engine::init() {
     case graphics::renderer::RendererType::Null:
         renderer = std::make_unique<graphics::renderer::NullRenderer>();
         break;
+    case graphics::renderer::RendererType::Software:
+        renderer = std::make_unique<graphics::renderer::SoftwareRenderer>();
+        break;
     case graphics::renderer::RendererType::Unknown:
         renderer = nullptr;
         return;
@@ -81,6 +135,9 @@ void Engine::init() {
     case input::InputType::GL:
         input = std::make_unique<input::GLInput>();
         break;
+    case input::InputType::Null:
+        input = std::make_unique<input::NullInput>();
+        break;
     case input::InputType::Unknown:
         input = nullptr;
         return;
@@ -92,7 +149,17 @@ void Engine::init() {
     input->Init();
     input->setButtonCallback([this]() { renderer->update(); });
     map    = std::make_unique<game::Map>();
+    world  = std::make_unique<game::World>();
     player = std::make_unique<game::Player>();
+    wallTextures.clear();
+    for (const auto& handle : wallHandles)
+        graphics::image::TextureManager::get().unpin(handle);
+    wallHandles.fill({});
+    camera.setFov({settings.fov, math::geometry::Angle::Unit::Degree});
+    tool::Tracker::get().captureSites(settings.allocationSites > 0);
+    graphics::image::TextureManager::get().setMipmaps(settings.mipmaps);
+    graphics::image::TextureManager::get().setShadedCopies(settings.shadedTextures);
+    graphics::image::TextureManager::get().setLoaderThreads(settings.loaderThreads);
 
     status = Status::Ready;
     frames = engineClock::now();
@@ -101,21 +168,47 @@ void Engine::init() {
 void Engine::display() {
     if (status != Status::Running)
         return;
+    // allocations made since the previous call: one whole frame
+    frameAllocations                   = tool::Tracker::get().checkState();
+    // scratch buffers of the previous frame are all gone
+    frameArena.reset();
+    graphics::image::TextureManager::get().newFrame();
     const engineClock::time_point temp = engineClock::now();
     deltaMillis                  = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(temp - frames).count());
     fps                          = 1000.0 / deltaMillis;
     frames                       = temp;
     button();
     renderer->update();
-    if (settings.drawMap)
+    // the whole grid of a paged level is not in memory
+    if (settings.drawMap && !isLevelPaged())
         drawMap();
     drawRayCasting();
-    if (settings.drawMap)
+    if (settings.drawMap && !isLevelPaged())
         drawPlayerOnMap();
     // draw fps.
-    std::stringstream text;
-    text << "fps " << fps;
-    renderer->drawText(text.str(), {875, 50}, {200U, 20U, 0U});
+    std::pmr::string text{"fps ", &frameArena};
+    appendNumber(text, fps);
+    renderer->drawText(text, {875, 50}, {200U, 20U, 0U});
+    if constexpr (tool::Tracker::enabled) {
+        text = "alloc ";
+        appendNumber(text, frameAllocations.m_allocationCalls);
+        text += " calls ";
+        appendNumber(text, frameAllocations.m_allocatedBytes);
+        text += " bytes, peak ";
+        appendNumber(text, frameAllocations.m_memoryPeek);
+        renderer->drawText(text, {875, 75}, {200U, 20U, 0U});
+    }
+    const auto& loading = graphics::image::TextureManager::get().getLoadingStats();
+    text                = "tex hitches ";
+    appendNumber(text, loading.hitches);
+    text += " placeholders ";
+    appendNumber(text, loading.placeholders);
+    text += " load ";
+    appendNumber(text, loading.meanLatency());
+    text += " ms, max ";
+    appendNumber(text, loading.maxLatency);
+    text += " ms";
+    renderer->drawText(text, {875, 100}, {200U, 20U, 0U});
 }
 
 void Engine::button() {
@@ -126,16 +219,16 @@ void Engine::button() {
         player->rotate({0.2 * deltaMillis, math::geometry::Angle::Unit::Degree});
     }
     if (input->isKeyPressed(input::FunctionKey::Forward)) {
-        player->move(map->possibleMove(player->getPosition(), player->getDirection() * static_cast<double>(deltaMillis)) * 0.2);
+        player->move(possibleMove(player->getDirection() * static_cast<double>(deltaMillis)) * 0.2);
     }
     if (input->isKeyPressed(input::FunctionKey::Backward)) {
-        player->move(map->possibleMove(player->getPosition(), player->getDirection() * -static_cast<double>(deltaMillis)) * 0.2);
+        player->move(possibleMove(player->getDirection() * -static_cast<double>(deltaMillis)) * 0.2);
     }
     if (input->isKeyPressed(input::FunctionKey::StrafeLeft)) {
-        player->move(map->possibleMove(player->getPosition(), player->getDirection().rotated90() * static_cast<double>(deltaMillis)) * 0.2);
+        player->move(possibleMove(player->getDirection().rotated90() * static_cast<double>(deltaMillis)) * 0.2);
     }
     if (input->isKeyPressed(input::FunctionKey::StrafeRight)) {
-        player->move(map->possibleMove(player->getPosition(), player->getDirection().rotated90() * -static_cast<double>(deltaMillis)) * 0.2);
+        player->move(possibleMove(player->getDirection().rotated90() * -static_cast<double>(deltaMillis)) * 0.2);
     }
 
     // toggle button: freeze time
@@ -162,8 +255,16 @@ void Engine::button() {
         // exit action
         freeze = frames;
         graphics::image::TextureManager::get().unloadAll();
-        const auto& res = tool::Tracker::get().globals();
-        std::cout << "\n\nMemory Statistics: " << res.m_allocatedMemory << " bytes remaining, max memory used: " << res.m_memoryPeek << ".\n Calls alloc/dealloc: " << res.m_allocationCalls << "/" << res.m_deallocationCalls << "\n\n";
+        if constexpr (tool::Tracker::enabled) {
+            const auto& res = tool::Tracker::get().globals();
+            std::cout << "\n\nMemory Statistics: " << res.m_allocatedMemory << " bytes remaining, max memory used: " << res.m_memoryPeek << ".\n Calls alloc/dealloc: " << res.m_allocationCalls << "/" << res.m_deallocationCalls << "\n\n";
+            if (settings.allocationSites > 0) {
+                std::cout << "Top allocation sites (resolve with addr2line):\n";
+                for (const auto& site : tool::Tracker::get().topSites(settings.allocationSites))
+                    std::cout << " " << site.m_caller << " up to " << site.m_sizeClass << " bytes: " << site.m_calls << " calls, " << site.m_bytes << " bytes\n";
+                std::cout << "\n";
+            }
+        }
         exit(0);
     }
 }
@@ -181,75 +282,112 @@ graphics::renderer::BaseRenderer* Engine::getRenderer() {
 }
 
 void Engine::drawRayCasting() {
-    using Unit             = rc::math::geometry::Angle::Unit;
-    const double fov       = 60.0;
-    const double increment = fov / settings.layout3D.width();
     auto& texMng = graphics::image::TextureManager::get();
-    // Sky and floor
-    renderer->drawQuad({{static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D[0][1])},
-                        {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D[0][1])},
-                        {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D.center()[1])},
-                        {static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D.center()[1])}},
-                       {65, 65, 65});
-    renderer->drawQuad({{static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D.center()[1])},
-                        {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D.center()[1])},
-                        {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D[1][1])},
-                        {static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D[1][1])}},
-                       {105, 105, 105});
-    const uint16_t halfHeight = static_cast<uint16_t>(settings.layout3D.height() / 2);
-    // ray casting — build ray directions
-    const int32_t rayCount = settings.layout3D.width() + 1;
-    struct RayInput {
-        int32_t index;
-        math::geometry::Vectf direction;
-    };
-    std::vector<RayInput> rayInputs;
-    rayInputs.reserve(rayCount);
-    {
-        auto ray = player->getDirection().rotated(rc::math::geometry::Angle{-fov / 2, Unit::Degree});
-        for (int32_t rays = 0; rays < rayCount; ++rays) {
-            rayInputs.push_back({rays, ray});
-            ray.rotate(rc::math::geometry::Angle{increment, Unit::Degree});
-        }
+    constexpr graphics::Color skyColor{65, 65, 65};
+    constexpr graphics::Color floorColor{105, 105, 105};
+    const auto viewWidth  = static_cast<size_t>(std::max(settings.layout3D.width(), 0));
+    const auto viewHeight = static_cast<int32_t>(std::max(settings.layout3D.height(), 0));
+    if (settings.compositeView) {
+        // kept from frame to frame: resized only when the layout changes
+        if (view.width() != viewWidth || view.height() != static_cast<size_t>(viewHeight))
+            view.resize(viewWidth, static_cast<size_t>(viewHeight));
+    } else {
+        // Sky and floor
+        renderer->drawQuad({{static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D[0][1])},
+                            {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D[0][1])},
+                            {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D.center()[1])},
+                            {static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D.center()[1])}},
+                           skyColor);
+        renderer->drawQuad({{static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D.center()[1])},
+                            {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D.center()[1])},
+                            {static_cast<double>(settings.layout3D[1][0]), static_cast<double>(settings.layout3D[1][1])},
+                            {static_cast<double>(settings.layout3D[0][0]), static_cast<double>(settings.layout3D[1][1])}},
+                           floorColor);
     }
-    // parallel computation of ray results (no OpenGL calls)
-    struct RayResult {
-        int32_t index;
-        math::geometry::Vectf direction;
-        game::Map::rayCastResult cast;
-        game::Map::gridCoordinate cellCoord;
-    };
-    std::vector<RayResult> rayResults(rayCount);
+    const uint16_t halfHeight = static_cast<uint16_t>(settings.layout3D.height() / 2);
+    // ray casting — one ray per column, evenly spaced on the camera plane
+    camera.setDirection(player->getDirection());
+    std::pmr::vector<math::geometry::Vectf> rayDirections(static_cast<size_t>(settings.layout3D.width()) + 1, &frameArena);
+    camera.buildRays(rayDirections);
+    // parallel computation of ray results by packets of adjacent columns (no OpenGL calls)
+    constexpr size_t packetSize = 64;
+    std::pmr::vector<game::Map::rayCastResult> rayResults(rayDirections.size(), &frameArena);
+    std::pmr::vector<size_t> packets(&frameArena);
+    packets.reserve((rayDirections.size() + packetSize - 1) / packetSize);
+    for (size_t first = 0; first < rayDirections.size(); first += packetSize)
+        packets.push_back(first);
     const auto playerPos = player->getPosition();
-    const auto playerDir = player->getDirection();
-    std::for_each(std::execution::par_unseq, rayInputs.begin(), rayInputs.end(), [&rayResults, &playerPos, this](const RayInput& input) {
-        const auto result              = map->castRay(playerPos, input.direction);
-        const auto cellCoord           = map->whichCell(result.wallPoint);
-        map->at(cellCoord).isViewed    = true;
-        rayResults[input.index]        = {input.index, input.direction, result, cellCoord};
-    });
+    const double focal   = camera.getFocalLength(settings.layout3D.width());
+    const bool paged     = isLevelPaged();
+    if (paged) {
+        // the casts page chunks in: sequential, the chunks around the player loaded first
+        world->update(playerPos);
+        for (size_t index = 0; index < rayDirections.size(); ++index)
+            rayResults[index] = world->castRay(playerPos, rayDirections[index]);
+    } else {
+        std::for_each(std::execution::par_unseq, packets.begin(), packets.end(), [&rayDirections, &rayResults, &playerPos, this](size_t first) {
+            const size_t last = std::min(first + packetSize, rayDirections.size());
+            for (size_t index = first; index < last; ++index)
+                rayResults[index] = map->castRay(playerPos, rayDirections[index]);
+        });
+    }
+    const auto cellSize  = paged ? world->getCellSize() : map->getCellSize();
     // sequential rendering (OpenGL calls must happen on the main thread)
     const auto [scaleFactor, offsetPoint] = getMapLayoutInfo();
-    for (const auto& ray : rayResults) {
-        const game::Map::BaseType& cell = map->at(ray.cellCoord);
+    for (size_t index = 0; index < rayResults.size(); ++index) {
+        const auto& cast     = rayResults[index];
+        const auto cellCoord = game::grid::whichCell(cast.wallPoint, cellSize);
+        // ray that escaped an open map
+        if (paged ? !world->isIn(cellCoord) : !map->isIn(cellCoord)) {
+            if (settings.compositeView && index < viewWidth) {
+                graphics::fillColumn(view, index, 0, halfHeight, skyColor);
+                graphics::fillColumn(view, index, halfHeight, viewHeight, floorColor);
+            }
+            continue;
+        }
+        game::mapCell cell{};
+        if (paged) {
+            cell = world->at(cellCoord);
+        } else {
+            map->setViewed(cellCoord);
+            cell = map->at(cellCoord);
+        }
         graphics::Color color{cell.getRayColor()};
-        if (settings.drawRays && settings.drawMap) {
-            if (ray.cast.hitVertical) color.darken();
-            renderer->drawLine({playerPos * scaleFactor + offsetPoint, ray.direction, ray.cast.distance * scaleFactor}, 2, color);
+        if (settings.drawRays && settings.drawMap && !paged) {
+            if (cast.hitVertical) color.darken();
+            renderer->drawLine({playerPos * scaleFactor + offsetPoint, cast.wallPoint * scaleFactor + offsetPoint}, 2, color);
         }
-        const auto lineH = static_cast<int32_t>((map->getCellSize() * 2.4 * halfHeight) /
-                                                (ray.cast.distance * playerDir.dot(ray.direction)));
+        // perspective projection: divide by the depth, not the ray length (no fisheye)
+        const double depth = std::max(camera.getDepth(cast.wallPoint - playerPos), 1.0);
+        const auto lineH   = static_cast<int32_t>((cellSize * focal) / depth);
         double lineOff   = halfHeight - (lineH >> 1);
-        if (settings.drawTexture) {
-            const auto& tex = texMng.getTexture(cell.getTextureName());
-            const double texX = static_cast<double>(tex.width()) * ray.cast.hitXRatio / map->getCellSize();
-            renderer->drawTextureVerticalLine(ray.index, lineOff, lineH, tex, texX, settings.layout3D, ray.cast.hitVertical);
+        if (settings.compositeView) {
+            // whole column at once: sky, wall, floor
+            if (index >= viewWidth)
+                continue;
+            const auto wallTop = static_cast<int32_t>(lineOff);
+            graphics::fillColumn(view, index, 0, wallTop, skyColor);
+            graphics::fillColumn(view, index, wallTop + lineH, viewHeight, floorColor);
+            if (settings.drawTexture) {
+                // texture found by ID, at the mipmap level fitting the wall's height
+                const auto& tex   = wallTextures.getViewFor(cell.textureId, lineH);
+                const double texX = static_cast<double>(tex.width) * cast.hitXRatio / cellSize;
+                graphics::drawWallColumn(view, index, lineOff, lineH, tex, texX, 0, viewHeight, cast.hitVertical);
+            } else {
+                graphics::fillColumn(view, index, wallTop, wallTop + lineH, color);
+            }
+        } else if (settings.drawTexture) {
+            const auto& tex = texMng.getTexture(wallHandles[cell.textureId]);
+            const double texX = static_cast<double>(tex.width()) * cast.hitXRatio / cellSize;
+            renderer->drawTextureVerticalLine(static_cast<double>(index), lineOff, lineH, tex, texX, settings.layout3D, cast.hitVertical);
         } else {
-            const double lineX = ray.index + settings.layout3D.left();
+            const double lineX = static_cast<double>(index) + settings.layout3D.left();
             lineOff += settings.layout3D.top();
             renderer->drawLine({{lineX, lineOff}, {lineX, lineOff + lineH}}, 1, color);
         }
     }
+    if (settings.compositeView)
+        renderer->drawImage(view, settings.layout3D);
 }
 
 void Engine::drawMap() {
@@ -260,16 +398,20 @@ void Engine::drawMap() {
                                        math::geometry::Vectf{offset, offset},
                                        math::geometry::Vectf{offset, 0}};
     quad.move(offsetPoint);
-    for (game::Map::LineType& line : map->getMapData()) {
-        for (const auto& cell : line) {
-            if (cell.isViewed)
-                renderer->drawQuad(quad,
-                                   cell.passable ? graphics::Color{0, 0, 0} : cell.visibility ? graphics::Color{40, 40, 40} :
-                                                                                                cell.getMapColor());
-            quad.move({offset, 0});
+    const auto& cells = map->getMapData();
+    for (size_t idx = 0; idx < cells.size(); ++idx) {
+        // only the viewed flags are read for the cells not drawn
+        if (cells.isViewed(idx)) {
+            const auto cell = cells[idx];
+            renderer->drawQuad(quad,
+                               cell.passable ? graphics::Color{0, 0, 0} : cell.visibility ? graphics::Color{40, 40, 40} :
+                                                                                            cell.getMapColor());
+        }
+        quad.move({offset, 0});
+        if ((idx + 1) % map->stride() == 0) {
+            offsetPoint += {0, offset};
+            quad.moveTo(offsetPoint);
         }
-        offsetPoint += {0, offset};
-        quad.moveTo(offsetPoint);
     }
 }
 
@@ -298,10 +440,14 @@ void Engine::checkState() {
         status = Status::Error;
         return;
     }
-    if (map == nullptr) {
+    if (map == nullptr || world == nullptr) {
         status = Status::Error;
         return;
     }
+    if (isLevelPaged()) {
+        status = world->isIn(player->getPosition()) ? Status::Ready : Status::Error;
+        return;
+    }
     if (!map->isValid()) {
         status = Status::Error;
         return;
@@ -313,11 +459,45 @@ void Engine::checkState() {
     status = Status::Ready;
 }
 
+math::geometry::Vectf Engine::possibleMove(const math::geometry::Vectf& Expected) const {
+    if (isLevelPaged())
+        return world->possibleMove(player->getPosition(), Expected);
+    return map->possibleMove(player->getPosition(), Expected);
+}
+
 void Engine::mapLoad(const std::string& mapName) {
-    map->loadFromData(mapName);
-    const auto [pos, dir] = map->getPlayerStart();
+    // the large levels are not decoded at once: played by chunks from their binary file
+    if (settings.pagedLevelCells == 0 || !world->openData(mapName) || world->width() * world->height() <= settings.pagedLevelCells)
+        world->close();
+    if (isLevelPaged())
+        *map = game::Map();
+    else
+        map->loadFromData(mapName);
+    const auto [pos, dir] = isLevelPaged() ? world->getPlayerStart() : map->getPlayerStart();
     player->setPosition(pos);
     player->setDirection(dir);
+    buildWallTextures();
+}
+
+void Engine::buildWallTextures() {
+    auto& texMng = graphics::image::TextureManager::get();
+    wallTextures.clear();
+    // the previous map's textures may be evicted again
+    for (const auto& handle : wallHandles)
+        texMng.unpin(handle);
+    wallHandles.fill({});
+    const auto ids = isLevelPaged() ? world->getTextureIds() : map->getTextureIds();
+    // kept in memory while the map is played, all decoded before the first frame (in parallel with loader threads)
+    for (const auto id : ids) {
+        if (id >= wallHandles.size())
+            continue;
+        wallHandles[id] = texMng.getHandle(game::mapCell{false, false, id}.getTextureName());
+        texMng.pin(wallHandles[id]);
+    }
+    texMng.waitForLoads();
+    for (const auto id : ids)
+        if (id < wallHandles.size())
+            wallTextures.add(id, texMng.getTexture(wallHandles[id]));
 }
 
 void Engine::loadSettings(const std::string& filename) {
@@ -7,13 +7,20 @@
  */
 #pragma once
 
+#include "game/Camera.h"
 #include "game/Map.h"
 #include "game/Player.h"
+#include "game/World.h"
 #include "input/BaseInput.h"
 #include "math/geometry/Box2.h"
 #include "math/geometry/Line2.h"
 #include "math/geometry/Quad2.h"
+#include "graphics/image/TextureAtlas.h"
+#include "graphics/image/TextureManager.h"
 #include "graphics/renderer/BaseRenderer.h"
+#include "tool/FrameArena.h"
+#include "tool/Tracker.h"
+#include <array>
 #include <chrono>
 #include <memory>
 
@@ -49,6 +56,20 @@ struct EngineSettings {
     bool drawMap = false;
     /// If daw the rays in the map
     bool drawRays = false;
+    /// If the 3D scene is composed in a CPU frame buffer, given to the renderer as one image
+    bool compositeView = true;
+    /// If the textures keep a shaded copy for the shaded walls
+    bool shadedTextures = true;
+    /// If the textures keep a mip chain for the distant walls
+    bool mipmaps = true;
+    /// Amount of threads loading the textures in the background (0: loaded when first drawn)
+    size_t loaderThreads = 2;
+    /// Horizontal field of view of the 3D scene in degree
+    double fov = 60.0;
+    /// Amount of allocation sites reported at exit (0: sites are not recorded)
+    size_t allocationSites = 0;
+    /// Levels with more cells than this are played by chunks from their binary file (0: never)
+    size_t pagedLevelCells = size_t{1} << 22U;
     /**
      * @brief Set from json
      * @param data The input json
@@ -135,11 +156,30 @@ public:
      */
     void display();
 
+    /**
+     * @brief Get the heap allocations of the last frame
+     * @return Allocation state of the last complete frame
+     */
+    [[nodiscard]] const tool::Tracker::AllocationState& getFrameAllocations() const { return frameAllocations; }
+    /**
+     * @brief Access to the scratch memory of the frames
+     * @return The frame arena
+     */
+    [[nodiscard]] const tool::FrameArena& getFrameArena() const { return frameArena; }
+
     /**
      * @brief Load the map
      * @param mapName Name of the map to load
+     *
+     * A level with a binary file of more than pagedLevelCells cells is not loaded at once:
+     * it is played by chunks from its file, without the map display.
      */
     void mapLoad(const std::string& mapName);
+    /**
+     * @brief Check if the current level is played by chunks
+     * @return True if paged from its binary file
+     */
+    [[nodiscard]] bool isLevelPaged() const { return world != nullptr && world->isValid(); }
 
     /**
      * @brief Load setings from file
@@ -166,10 +206,20 @@ private:
       */
     void drawPlayerOnMap();
 
+    /**
+     * @brief Pack the wall textures used by the map in the atlas
+     */
+    void buildWallTextures();
     /**
      * @brief Check the engine state and update status
      */
     void checkState();
+    /**
+     * @brief Check and modify the expected player's move according to the level
+     * @param Expected Expected move
+     * @return Effective move
+     */
+    [[nodiscard]] math::geometry::Vectf possibleMove(const math::geometry::Vectf& Expected) const;
     /**
       * @brief Compute map layout infos
       * @return Scale factor and offset point
@@ -190,8 +240,12 @@ private:
     std::unique_ptr<input::BaseInput> input;
     /// Link to the map
     std::unique_ptr<game::Map> map;
+    /// Link to the level played by chunks, open only for the large levels
+    std::unique_ptr<game::World> world;
     /// Link to the player
     std::unique_ptr<game::Player> player;
+    /// The player's view
+    game::Camera camera;
 
     std::vector<std::function<void()>> toRender;
 
@@ -204,6 +258,16 @@ private:
     engineClock::time_point freeze;
     /// frames per second
     double fps = 0;
+    /// Heap allocations of the last frame
+    tool::Tracker::AllocationState frameAllocations;
+    /// Scratch memory of the current frame, released at the next frame
+    tool::FrameArena frameArena;
+    /// CPU frame buffer of the 3D scene
+    graphics::image::Texture view;
+    /// Wall textures of the current map, by texture ID
+    graphics::image::TextureAtlas wallTextures;
+    /// Texture manager's handles of the wall textures of the current map, by texture ID
+    std::array<graphics::image::TextureHandle, graphics::image::TextureAtlas::slotCount> wallHandles{};
 };
 
 }// namespace rc::core
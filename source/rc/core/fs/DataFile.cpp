@@ -76,6 +76,12 @@ void DataFile::writeJson(const nlohmann::json& data) const {
     jFile.close();
 }
 
+void DataFile::writeBinary(std::span<const uint8_t> data) const {
+    std::ofstream file(getFullPath(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    file.close();
+}
+
 void DataFile::touch() const {
     if (std::filesystem::exists(getFullPath())){
         std::filesystem::last_write_time(getFullPath(), std::chrono::file_clock::now());
@@ -9,6 +9,7 @@
 #pragma once
 #include <filesystem>
 #include <nlohmann/json.hpp>
+#include <span>
 
 /**
  * @brief Namespace for filesystem management
@@ -121,6 +122,12 @@ public:
      * @param data Json to write in file
      */
     void writeJson(const nlohmann::json& data)const;
+
+    /**
+     * @brief Open data file for writing raw bytes
+     * @param data Bytes to write in file
+     */
+    void writeBinary(std::span<const uint8_t> data) const;
 private:
     /// Path to the file relative to DataPath
     path filePath;
@@ -0,0 +1,78 @@
+/**
+ * @file MappedFile.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "MappedFile.h"
+#include <utility>
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rc::core::fs {
+
+MappedFile::MappedFile(const path& file) {
+#if defined(_WIN32)
+    std::ifstream stream(file, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) return;
+    m_buffer.resize(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    if (m_buffer.empty() || !stream.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()))) {
+        m_buffer.clear();
+        return;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#else
+    const int descriptor = ::open(file.c_str(), O_RDONLY);
+    if (descriptor < 0) return;
+    struct stat status {};
+    if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        const auto size = static_cast<size_t>(status.st_size);
+        void* mapping   = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED) {
+            m_data = static_cast<const uint8_t*>(mapping);
+            m_size = size;
+        }
+    }
+    // the mapping stays valid once the descriptor is closed
+    ::close(descriptor);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+    m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)}, m_buffer{std::move(other.m_buffer)} {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_data   = std::exchange(other.m_data, nullptr);
+        m_size   = std::exchange(other.m_size, 0);
+        m_buffer = std::move(other.m_buffer);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close() {
+#if !defined(_WIN32)
+    if (m_data != nullptr)
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_buffer.clear();
+}
+
+}// namespace rc::core::fs
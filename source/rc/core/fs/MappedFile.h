@@ -0,0 +1,86 @@
+/**
+ * @file MappedFile.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace rc::core::fs {
+
+/**
+ * @brief Class MappedFile
+ *
+ * Read only view on the whole content of a file, mapped in memory: pages are read by
+ * the system when first touched, without copy. On systems without mmap, the file is
+ * read in a buffer.
+ */
+class MappedFile {
+public:
+    /// Type for path
+    using path = std::filesystem::path;
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    /**
+     * @brief Move constructor
+     * @param other The file to take the mapping from
+     */
+    MappedFile(MappedFile&& other) noexcept;
+    /**
+     * @brief Move assignation
+     * @param other The file to take the mapping from
+     * @return this
+     */
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    /**
+     * @brief Default constructor: no file
+     */
+    MappedFile() = default;
+    /**
+     * @brief Map a file
+     * @param file The file's full path
+     */
+    explicit MappedFile(const path& file);
+    /**
+     * @brief Destructor, unmap the file
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Check if the file could be mapped
+     * @return True if mapped (an empty file is never mapped)
+     */
+    [[nodiscard]] bool isOpen() const { return m_data != nullptr; }
+    /**
+     * @brief Access to the file's content
+     * @return The bytes of the file
+     */
+    [[nodiscard]] std::span<const uint8_t> data() const { return {m_data, m_size}; }
+    /**
+     * @brief Get the file's size
+     * @return Size in bytes
+     */
+    [[nodiscard]] size_t size() const { return m_size; }
+
+private:
+    /**
+     * @brief Release the mapping
+     */
+    void close();
+
+    /// First byte of the file
+    const uint8_t* m_data = nullptr;
+    /// Size of the file
+    size_t m_size = 0;
+    /// Content of the file when it cannot be mapped
+    std::vector<uint8_t> m_buffer;
+};
+
+}// namespace rc::core::fs
@@ -19,6 +19,7 @@ namespace rc::core::input {
 enum struct InputType {
     Unknown,///< Unknown input
     GL,     ///< Glut-based input
+    Null,   ///< No input device (headless runs)
 };
 
 /**
@@ -0,0 +1,49 @@
+/**
+ * @file NullInput.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "BaseInput.h"
+
+namespace rc::core::input {
+
+/**
+ * @brief Class NullInput
+ *
+ * Input without any device: no key is ever pressed. Used for headless runs.
+ */
+class NullInput : public BaseInput {
+public:
+    NullInput(const NullInput&)            = delete;
+    NullInput(NullInput&&)                 = delete;
+    NullInput& operator=(const NullInput&) = delete;
+    NullInput& operator=(NullInput&&)      = delete;
+    /**
+     * @brief Default constructor.
+     */
+    NullInput() = default;
+    /**
+     * @brief Destructor.
+     */
+    ~NullInput() override = default;
+    /**
+     * @brief Initialize the input
+     */
+    void Init() override {}
+    /**
+     * @brief Defines the button call back
+     * @param func The button callback
+     */
+    void setButtonCallback([[maybe_unused]] const std::function<void()>& func) override {}
+    /**
+     * @brief Gets the input Type
+     * @return Input type
+     */
+    [[nodiscard]] InputType getType() const override { return InputType::Null; }
+};
+
+}// namespace rc::core::input
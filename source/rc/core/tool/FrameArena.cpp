@@ -0,0 +1,64 @@
+/**
+ * @file FrameArena.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "FrameArena.h"
+#include <algorithm>
+#include <new>
+
+namespace rc::core::tool {
+
+FrameArena::FrameArena(size_t capacity) : m_capacity{capacity} {
+    if (m_capacity > 0)
+        m_buffer = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+}
+
+FrameArena::~FrameArena() {
+    releaseOverflow();
+}
+
+void FrameArena::reset() {
+    m_highWater = std::max(m_highWater, m_used);
+    if (m_overflow != nullptr) {
+        releaseOverflow();
+        // some head room, for the frames slightly bigger than this one
+        m_capacity = m_highWater + m_highWater / 4;
+        m_buffer   = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+    }
+    m_offset = 0;
+    m_used   = 0;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    void* ptr    = m_buffer.get() + m_offset;
+    size_t space = m_capacity - m_offset;
+    if (m_buffer != nullptr && std::align(alignment, bytes, ptr, space) != nullptr) {
+        const size_t end = m_capacity - space + bytes;
+        m_used += end - m_offset;
+        m_offset = end;
+        return ptr;
+    }
+    // block full: fall back to the heap until the next reset
+    const size_t blockSize = sizeof(Overflow) + alignment + bytes;
+    auto* block            = new std::byte[blockSize];
+    m_overflow             = new (block) Overflow{m_overflow};
+    ptr                    = block + sizeof(Overflow);
+    space                  = blockSize - sizeof(Overflow);
+    ++m_overflowCount;
+    m_used += alignment + bytes;
+    return std::align(alignment, bytes, ptr, space);
+}
+
+void FrameArena::releaseOverflow() {
+    while (m_overflow != nullptr) {
+        Overflow* next = m_overflow->m_next;
+        delete[] reinterpret_cast<std::byte*>(m_overflow);
+        m_overflow = next;
+    }
+}
+
+}// namespace rc::core::tool
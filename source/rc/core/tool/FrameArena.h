@@ -0,0 +1,118 @@
+/**
+ * @file FrameArena.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace rc::core::tool {
+
+/**
+ * @brief Class FrameArena
+ *
+ * Linear allocator for the scratch buffers of one frame: allocation is a pointer bump,
+ * deallocation does nothing, and everything is released at once by reset(). It is a
+ * std::pmr::memory_resource, so standard containers (std::pmr::vector, std::pmr::string)
+ * can live in it.
+ *
+ * When a frame needs more than the capacity, the extra allocations go to the heap and
+ * the next reset() grows the block to the frame's high water mark: after the first frames
+ * the arena no longer touches the heap. Not thread-safe: allocate from one thread only.
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena(FrameArena&&)                 = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena& operator=(FrameArena&&)      = delete;
+    /**
+     * @brief Constructor
+     * @param capacity Initial capacity in bytes
+     */
+    explicit FrameArena(size_t capacity = 0);
+    /**
+     * @brief Destructor.
+     */
+    ~FrameArena() override;
+
+    /**
+     * @brief Release every allocation and start a new frame
+     *
+     * Containers using the arena must have been destroyed before.
+     */
+    void reset();
+
+    /**
+     * @brief Get the size of the arena's block
+     * @return Capacity in bytes
+     */
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+    /**
+     * @brief Get the memory used in the current frame, alignment included
+     * @return Used bytes
+     */
+    [[nodiscard]] size_t used() const { return m_used; }
+    /**
+     * @brief Get the most memory used by a frame since the arena creation
+     * @return Used bytes
+     */
+    [[nodiscard]] size_t highWater() const { return m_highWater; }
+    /**
+     * @brief Get the amount of heap allocations made since the arena creation because the block was full
+     * @return Amount of allocations
+     */
+    [[nodiscard]] size_t overflowCount() const { return m_overflowCount; }
+
+private:
+    /**
+     * @brief Allocate memory in the arena
+     * @param bytes Size to allocate
+     * @param alignment Required alignment
+     * @return Pointer to the memory
+     */
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    /**
+     * @brief Deallocate memory: nothing until reset
+     */
+    void do_deallocate(void*, size_t, size_t) override {}
+    /**
+     * @brief Compare memory resources
+     * @param other The other resource
+     * @return True if the same arena
+     */
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    /**
+     * @brief Heap block holding the allocations that did not fit in the arena
+     */
+    struct Overflow {
+        Overflow* m_next = nullptr;///< Previous overflow block of the frame
+    };
+    /**
+     * @brief Free the overflow blocks
+     */
+    void releaseOverflow();
+
+    /// The arena's block
+    std::unique_ptr<std::byte[]> m_buffer;
+    /// Size of the block
+    size_t m_capacity = 0;
+    /// First free byte of the block
+    size_t m_offset = 0;
+    /// Memory used in the current frame (overflow included)
+    size_t m_used = 0;
+    /// Most memory used by a frame
+    size_t m_highWater = 0;
+    /// Overflow blocks of the current frame
+    Overflow* m_overflow = nullptr;
+    /// Total amount of overflow allocations
+    size_t m_overflowCount = 0;
+};
+
+}// namespace rc::core::tool
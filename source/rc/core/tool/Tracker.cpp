@@ -7,8 +7,11 @@
  */
 
 #include "Tracker.h"
+#include <algorithm>
+#include <bit>
 #include <memory>
 
+#if RAYCAST_MEMORY_TRACKER
 /**
  * @brief Overload of standard memory deallocation
  * @param memory Memory to free
@@ -22,7 +25,7 @@ void operator delete(void* memory, size_t size)noexcept;
  * @return Pointer to allocated memory
  */
 [[nodiscard]] void* operator new(size_t size){
-    rc::core::tool::Tracker::get().allocate(size);
+    rc::core::tool::Tracker::get().allocate(size, __builtin_return_address(0));
     return malloc(size);
 }
 
@@ -35,35 +38,102 @@ void operator delete(void* memory, size_t size)noexcept{
  * @param memory Memory to free
  */
 void operator delete(void* memory)noexcept{ free(memory);}
+#endif
 
 namespace rc::core::tool {
 
-void Tracker::allocate(size_t size) {
-    ++m_currentAllocationState.m_allocationCalls;
-    m_currentAllocationState.m_allocatedMemory+=size;
-    m_currentAllocationState.m_memoryPeek = std::max(m_currentAllocationState.m_memoryPeek, m_currentAllocationState.m_allocatedMemory);
-    ++m_globalAllocationState.m_allocationCalls;
-    m_globalAllocationState.m_allocatedMemory+=size;
-    m_globalAllocationState.m_memoryPeek = std::max(m_globalAllocationState.m_memoryPeek, m_globalAllocationState.m_allocatedMemory);
+void Tracker::AtomicState::allocate(size_t size) {
+    m_allocationCalls.fetch_add(1, std::memory_order_relaxed);
+    m_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const size_t memory = m_allocatedMemory.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peek         = m_memoryPeek.load(std::memory_order_relaxed);
+    while (memory > peek && !m_memoryPeek.compare_exchange_weak(peek, memory, std::memory_order_relaxed)) {}
 }
-void Tracker::deallocate(size_t size) {
-    ++m_currentAllocationState.m_deallocationCalls;
-    m_currentAllocationState.m_allocatedMemory-=size;
-    ++m_globalAllocationState.m_deallocationCalls;
-    m_globalAllocationState.m_allocatedMemory-=size;
+
+void Tracker::AtomicState::deallocate(size_t size) {
+    m_deallocationCalls.fetch_add(1, std::memory_order_relaxed);
+    m_allocatedMemory.fetch_sub(size, std::memory_order_relaxed);
 }
 
-const Tracker::AllocationState& Tracker::checkState() {
+void Tracker::allocate([[maybe_unused]] size_t size, [[maybe_unused]] const void* caller) {
+    if constexpr (enabled) {
+        m_currentAllocationState.allocate(size);
+        m_globalAllocationState.allocate(size);
+        if (caller != nullptr && m_captureSites.load(std::memory_order_relaxed))
+            recordSite(size, caller);
+    }
+}
 
-    m_lastAllocationState.m_allocatedMemory=0;
-    m_lastAllocationState.m_allocationCalls=0;
-    m_lastAllocationState.m_deallocationCalls=0;
-    m_lastAllocationState.m_memoryPeek=0;
-    std::swap(m_currentAllocationState,m_lastAllocationState);
+void Tracker::recordSite(size_t size, const void* caller) {
+    // user space addresses fit in 58 bits, the low 6 bits hold the size class
+    const auto sizeClass = static_cast<uint64_t>(std::bit_width(size > 0 ? size - 1 : 0));
+    const uint64_t key   = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(caller)) << 6U) | sizeClass;
+    size_t slot          = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 54U) & (siteCapacity - 1);
+    for (size_t probe = 0; probe < siteCapacity; ++probe, slot = (slot + 1) & (siteCapacity - 1)) {
+        auto& site       = m_sites[slot];
+        uint64_t current = site.m_key.load(std::memory_order_relaxed);
+        if (current == 0 && site.m_key.compare_exchange_strong(current, key, std::memory_order_relaxed))
+            current = key;
+        if (current == key) {
+            site.m_calls.fetch_add(1, std::memory_order_relaxed);
+            site.m_bytes.fetch_add(size, std::memory_order_relaxed);
+            return;
+        }
+    }
+    m_droppedSites.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<Tracker::AllocationSite> Tracker::topSites(size_t count) const {
+    std::vector<AllocationSite> sites;
+    for (const auto& site : m_sites) {
+        const uint64_t key = site.m_key.load(std::memory_order_relaxed);
+        if (key == 0)
+            continue;
+        sites.push_back({reinterpret_cast<const void*>(static_cast<uintptr_t>(key >> 6U)),
+                         size_t{1} << (key & 63U),
+                         site.m_calls.load(std::memory_order_relaxed),
+                         site.m_bytes.load(std::memory_order_relaxed)});
+    }
+    const auto byBytes = [](const AllocationSite& a, const AllocationSite& b) { return a.m_bytes > b.m_bytes; };
+    if (count < sites.size()) {
+        std::partial_sort(sites.begin(), sites.begin() + static_cast<std::ptrdiff_t>(count), sites.end(), byBytes);
+        sites.resize(count);
+    } else {
+        std::sort(sites.begin(), sites.end(), byBytes);
+    }
+    return sites;
+}
+
+void Tracker::resetSites() {
+    for (auto& site : m_sites) {
+        site.m_key.store(0, std::memory_order_relaxed);
+        site.m_calls.store(0, std::memory_order_relaxed);
+        site.m_bytes.store(0, std::memory_order_relaxed);
+    }
+    m_droppedSites.store(0, std::memory_order_relaxed);
+}
+void Tracker::deallocate([[maybe_unused]] size_t size) {
+    if constexpr (enabled) {
+        m_currentAllocationState.deallocate(size);
+        m_globalAllocationState.deallocate(size);
+    }
+}
+
+const Tracker::AllocationState& Tracker::checkState() {
+    m_lastAllocationState.m_allocatedMemory   = m_currentAllocationState.m_allocatedMemory.exchange(0, std::memory_order_relaxed);
+    m_lastAllocationState.m_allocationCalls   = m_currentAllocationState.m_allocationCalls.exchange(0, std::memory_order_relaxed);
+    m_lastAllocationState.m_deallocationCalls = m_currentAllocationState.m_deallocationCalls.exchange(0, std::memory_order_relaxed);
+    m_lastAllocationState.m_memoryPeek        = m_currentAllocationState.m_memoryPeek.exchange(0, std::memory_order_relaxed);
+    m_lastAllocationState.m_allocatedBytes    = m_currentAllocationState.m_allocatedBytes.exchange(0, std::memory_order_relaxed);
     return m_lastAllocationState;
 }
 const Tracker::AllocationState& Tracker::globals()const {
-    return m_globalAllocationState;
+    m_globalSnapshot.m_allocatedMemory   = m_globalAllocationState.m_allocatedMemory.load(std::memory_order_relaxed);
+    m_globalSnapshot.m_allocationCalls   = m_globalAllocationState.m_allocationCalls.load(std::memory_order_relaxed);
+    m_globalSnapshot.m_deallocationCalls = m_globalAllocationState.m_deallocationCalls.load(std::memory_order_relaxed);
+    m_globalSnapshot.m_memoryPeek        = m_globalAllocationState.m_memoryPeek.load(std::memory_order_relaxed);
+    m_globalSnapshot.m_allocatedBytes    = m_globalAllocationState.m_allocatedBytes.load(std::memory_order_relaxed);
+    return m_globalSnapshot;
 }
 
 Tracker::~Tracker() {
@@ -7,11 +7,24 @@
  */
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <vector>
+
+#ifndef RAYCAST_MEMORY_TRACKER
+/// Count the heap allocations through the global operator new (0 to compile it out)
+#define RAYCAST_MEMORY_TRACKER 1
+#endif
 
 namespace rc::core::tool {
 /**
  * @brief Class Tracker
+ *
+ * Counters are relaxed atomics: allocations may come from any thread (parallel
+ * algorithms, thread pools). When RAYCAST_MEMORY_TRACKER is 0, the global operator new
+ * is not replaced and the tracker always reports empty states.
  */
 class Tracker {
 public:
@@ -32,11 +45,15 @@ public:
         return instance;
     }
 
+    /// If the allocations are tracked in this build
+    static constexpr bool enabled = RAYCAST_MEMORY_TRACKER != 0;
+
     /**
      * @brief Function called at each allocation
      * @param size The Allocated size
+     * @param caller Return address of the allocation call, for the site capture
      */
-    void allocate(size_t size);
+    void allocate(size_t size, const void* caller = nullptr);
 
     /**
      * @brief Function called each deallocation
@@ -52,11 +69,50 @@ public:
         size_t m_allocationCalls = 0; ///< Amount of memory allocation calls
         size_t m_deallocationCalls = 0; ///< Amount of deallocation calls
         size_t m_memoryPeek = 0; ///< Max seen amount of memory
+        size_t m_allocatedBytes = 0; ///< Total amount of allocated memory (deallocations not subtracted)
     };
 
+    /**
+     * @brief Statistics of one allocation site
+     */
+    struct AllocationSite {
+        const void* m_caller = nullptr;///< Return address of the allocation call
+        size_t m_sizeClass   = 0;      ///< Allocations of this site up to this size (power of 2)
+        size_t m_calls       = 0;      ///< Amount of allocation calls
+        size_t m_bytes       = 0;      ///< Amount of allocated memory
+    };
+
+    /**
+     * @brief Start or stop recording allocation sites
+     * @param capture If sites are recorded
+     */
+    void captureSites(bool capture) { m_captureSites.store(capture, std::memory_order_relaxed); }
+    /**
+     * @brief Check if allocation sites are recorded
+     * @return True if recording
+     */
+    [[nodiscard]] bool isCapturingSites() const { return m_captureSites.load(std::memory_order_relaxed); }
+    /**
+     * @brief Get the allocation sites that allocated the most memory
+     * @param count Maximum amount of sites
+     * @return The sites, sorted by decreasing allocated memory
+     */
+    [[nodiscard]] std::vector<AllocationSite> topSites(size_t count) const;
+    /**
+     * @brief Forget all recorded allocation sites
+     */
+    void resetSites();
+    /**
+     * @brief Get the amount of allocations not recorded because the site table is full
+     * @return Amount of allocations
+     */
+    [[nodiscard]] size_t droppedSites() const { return m_droppedSites.load(std::memory_order_relaxed); }
+
     /**
      * @brief Reset current memory state monitor and give the previous status
      * @return Status since last call to check
+     *
+     * Allocations made by other threads during the call are counted in one of the two periods.
      */
     const AllocationState& checkState();
     /**
@@ -70,9 +126,56 @@ private:
      */
     Tracker() = default;
 
-    AllocationState m_globalAllocationState;
-    AllocationState m_currentAllocationState;
+    /**
+     * @brief Thread-safe counters of an allocation state
+     */
+    struct AtomicState {
+        std::atomic<size_t> m_allocatedMemory = 0;  ///< Amount of allocated memory
+        std::atomic<size_t> m_allocationCalls = 0;  ///< Amount of memory allocation calls
+        std::atomic<size_t> m_deallocationCalls = 0;///< Amount of deallocation calls
+        std::atomic<size_t> m_memoryPeek = 0;       ///< Max seen amount of memory
+        std::atomic<size_t> m_allocatedBytes = 0;   ///< Total amount of allocated memory
+        /**
+         * @brief Record an allocation
+         * @param size The Allocated size
+         */
+        void allocate(size_t size);
+        /**
+         * @brief Record a deallocation
+         * @param size Deallocation size
+         */
+        void deallocate(size_t size);
+    };
+    static_assert(std::atomic<size_t>::is_always_lock_free, "Allocation tracking must not lock");
+
+    /**
+     * @brief Slot of the allocation site table
+     */
+    struct SiteSlot {
+        std::atomic<uint64_t> m_key = 0;  ///< Caller and size class (0 for a free slot)
+        std::atomic<size_t> m_calls = 0;  ///< Amount of allocation calls
+        std::atomic<size_t> m_bytes = 0;  ///< Amount of allocated memory
+    };
+    /**
+     * @brief Record an allocation in the site table (lock-free, never allocates)
+     * @param size The Allocated size
+     * @param caller Return address of the allocation call
+     */
+    void recordSite(size_t size, const void* caller);
+    /// Capacity of the allocation site table (power of 2)
+    static constexpr size_t siteCapacity = 1024;
+    /// Allocation site table, open addressing
+    std::array<SiteSlot, siteCapacity> m_sites;
+    /// If sites are recorded
+    std::atomic<bool> m_captureSites = false;
+    /// Allocations not recorded because the table is full
+    std::atomic<size_t> m_droppedSites = 0;
+
+    AtomicState m_globalAllocationState;
+    AtomicState m_currentAllocationState;
     AllocationState m_lastAllocationState;
+    /// Copy of the global counters returned by globals()
+    mutable AllocationState m_globalSnapshot;
 
 };
 
@@ -0,0 +1,41 @@
+/**
+ * @file Camera.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "Camera.h"
+#include <algorithm>
+
+namespace rc::game {
+
+void Camera::setFov(const math::geometry::Angle& fieldOfView) {
+    using Unit = math::geometry::Angle::Unit;
+    fov.set(std::clamp(fieldOfView.getUnit(Unit::Degree), minFov, maxFov), Unit::Degree);
+    planeScale = std::tan(fov.get() / 2.0);
+    setDirection(direction);
+}
+
+void Camera::setDirection(const DirectionType& dir) {
+    direction = dir;
+    if (std::abs(dir.lengthSQ() - 1.0) > 0.0001)
+        direction /= direction.length();
+    // right side of the screen, opposite to Vector2::rotated90 that turns left
+    plane = direction.rotated90() * -planeScale;
+}
+
+void Camera::buildRays(std::span<DirectionType> rays) const {
+    if (rays.empty())
+        return;
+    if (rays.size() == 1) {
+        rays.front() = direction;
+        return;
+    }
+    const double step = 2.0 / static_cast<double>(rays.size() - 1);
+    for (size_t col = 0; col < rays.size(); ++col)
+        rays[col] = getRay(static_cast<double>(col) * step - 1.0);
+}
+
+}// namespace rc::game
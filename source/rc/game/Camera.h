@@ -0,0 +1,128 @@
+/**
+ * @file Camera.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+
+#include "math/geometry/Vector2.h"
+#include <span>
+
+namespace rc::game {
+
+/**
+ * @brief Class Camera
+ *
+ * Pinhole camera of the ray caster: a unit view direction and a camera plane
+ * perpendicular to it, whose half length is tan(fov/2). Screen columns are evenly
+ * spaced on that plane, so ray directions are a linear interpolation between its
+ * ends: no trigonometry per column, and no fisheye once distances are measured
+ * perpendicular to the plane (see getDepth).
+ */
+class Camera {
+public:
+    /// Direction's type
+    using DirectionType = math::geometry::Vectf;
+    /**
+     * @brief Default copy constructor
+     */
+    Camera(const Camera&) = default;
+    /**
+     * @brief Default move constructor
+     */
+    Camera(Camera&&) = default;
+    /**
+     * @brief Default copy assignation
+     * @return this
+     */
+    Camera& operator=(const Camera&) = default;
+    /**
+     * @brief Default move assignation
+     * @return this
+     */
+    Camera& operator=(Camera&&) = default;
+    /**
+     * @brief Default constructor: 60° field of view, looking along X.
+     */
+    Camera() = default;
+    /**
+     * @brief Constructor with field of view
+     * @param fieldOfView The horizontal field of view
+     */
+    explicit Camera(const math::geometry::Angle& fieldOfView) { setFov(fieldOfView); }
+    /**
+     * @brief Destructor.
+     */
+    ~Camera() = default;//---UNCOVER---
+
+    /**
+     * @brief Define the horizontal field of view
+     * @param fieldOfView The field of view, clamped between minFov and maxFov
+     */
+    void setFov(const math::geometry::Angle& fieldOfView);
+    /**
+     * @brief Access to the horizontal field of view
+     * @return The field of view
+     */
+    [[nodiscard]] const math::geometry::Angle& getFov() const { return fov; }
+    /**
+     * @brief Define the view direction
+     * @param dir The direction (normalized if needed)
+     */
+    void setDirection(const DirectionType& dir);
+    /**
+     * @brief Access to the view direction
+     * @return The unit view direction
+     */
+    [[nodiscard]] const DirectionType& getDirection() const { return direction; }
+    /**
+     * @brief Access to the camera plane
+     * @return Vector from the screen center to the right edge of the screen
+     */
+    [[nodiscard]] const DirectionType& getPlane() const { return plane; }
+
+    /**
+     * @brief Get a ray direction
+     * @param screenX Horizontal screen position: -1 on the left edge, 1 on the right edge
+     * @return The ray direction (not normalized)
+     */
+    [[nodiscard]] DirectionType getRay(double screenX) const { return direction + plane * screenX; }
+    /**
+     * @brief Build the rays of evenly spaced screen columns, from left edge to right edge
+     * @param rays The ray directions (not normalized), one per column
+     */
+    void buildRays(std::span<DirectionType> rays) const;
+
+    /**
+     * @brief Get the distance of a point to the camera plane
+     * @param offset Point position, relative to the camera
+     * @return The depth
+     */
+    [[nodiscard]] double getDepth(const DirectionType& offset) const { return offset.dot(direction); }
+    /**
+     * @brief Get the focal length in pixels
+     * @param screenWidth Width of the screen in pixels
+     * @return The focal length
+     */
+    [[nodiscard]] double getFocalLength(double screenWidth) const { return screenWidth / (2.0 * planeScale); }
+
+    /// Smallest field of view in degree
+    static constexpr double minFov = 1.0;
+    /// Largest field of view in degree
+    static constexpr double maxFov = 170.0;
+
+private:
+    /// Horizontal field of view
+    math::geometry::Angle fov{60.0, math::geometry::Angle::Unit::Degree};
+    /// Half length of the camera plane: tan(fov/2)
+    double planeScale = std::tan(fov.get() / 2.0);
+    /// Unit view direction
+    DirectionType direction{1.0, 0.0};
+    /// Camera plane
+    DirectionType plane{0.0, planeScale};
+};
+
+}// namespace rc::game
@@ -0,0 +1,131 @@
+/**
+ * @file Grid.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Map.h"
+#include <algorithm>
+#include <span>
+
+/**
+ * @brief Grid queries shared by the map and the chunked world: both give the same answers
+ */
+namespace rc::game::grid {
+
+/**
+ * @brief Convert a world coordinate into a grid index
+ * @param coordinate World coordinate
+ * @param cubeSize Size of a cell
+ * @return Grid index, max index if outside
+ */
+inline Map::IndexType toGridIndex(double coordinate, Map::CellSizeType cubeSize) {
+    if (coordinate < 0)
+        return static_cast<Map::IndexType>(Map::maxSize);
+    const uint64_t index = static_cast<uint64_t>(coordinate) / cubeSize;
+    return index >= Map::maxSize ? static_cast<Map::IndexType>(Map::maxSize) : static_cast<Map::IndexType>(index);
+}
+
+/**
+ * @brief Determine the cell where the point lies.
+ * @param from The point to check
+ * @param cubeSize Size of a cell
+ * @return The cell, coordinates outside the map give the max index
+ */
+inline Map::gridCoordinate whichCell(const Map::worldCoordinates& from, Map::CellSizeType cubeSize) {
+    return {toGridIndex(from[0], cubeSize), toGridIndex(from[1], cubeSize)};
+}
+
+/**
+ * @brief Check if a point is in a grid
+ * @param from The point to check
+ * @param columns Cells per line
+ * @param lines Amount of lines
+ * @param cubeSize Size of a cell
+ * @return True if in the grid
+ */
+inline bool isIn(const Map::worldCoordinates& from, size_t columns, size_t lines, Map::CellSizeType cubeSize) {
+    return from[0] >= 0 && from[0] <= static_cast<double>(columns * cubeSize) && from[1] >= 0 && from[1] <= static_cast<double>(lines * cubeSize);
+}
+
+/**
+ * @brief Checks if grid coordinates are in a grid
+ * @param from Grid coordinates to check
+ * @param columns Cells per line
+ * @param lines Amount of lines
+ * @return True if in the grid
+ */
+inline bool isIn(const Map::gridCoordinate& from, size_t columns, size_t lines) {
+    return from[0] < columns && from[1] < lines;
+}
+
+/**
+ * @brief Check and modify the expected move according to the grid constrains
+ * @tparam Passable Callable as passable(point), true if the point is in the grid and player can pass through
+ * @param Start Actual Position
+ * @param Expected Expected move
+ * @param passable The passability check
+ * @return Effective move
+ */
+template<class Passable>
+Map::worldCoordinates possibleMove(const Map::worldCoordinates& Start, const Map::worldCoordinates& Expected, Passable&& passable) {
+    if (passable(Start + Expected))
+        return Expected;
+    if (passable(Start + Map::worldCoordinates{Expected[0], 0.0}))
+        return {Expected[0], 0.0};
+    if (passable(Start + Map::worldCoordinates{0.0, Expected[1]}))
+        return {0.0, Expected[1]};
+    return Map::worldCoordinates();
+}
+
+/**
+ * @brief Compute the distance field of an area of a grid
+ * @tparam Visible Callable as visible(index), true if the cell of this index is see-through
+ * @param field Distance of each cell to the nearest wall (0 for walls), line after line
+ * @param columns Cells per line
+ * @param lines Amount of lines
+ * @param firstX First column of the area
+ * @param firstY First line of the area
+ * @param lastX Last column of the area
+ * @param lastY Last line of the area
+ * @param visible The visibility check
+ *
+ * Chessboard distances, clamped to Map::maxDistance. The cells around the area keep their
+ * distance, outside the grid is a wall.
+ */
+template<class Visible>
+void computeDistances(std::span<uint8_t> field, size_t columns, size_t lines, size_t firstX, size_t firstY, size_t lastX, size_t lastY, Visible&& visible) {
+    const auto width  = static_cast<int64_t>(columns);
+    const auto height = static_cast<int64_t>(lines);
+    const auto distance = [&](int64_t posX, int64_t posY) -> uint8_t {
+        if (posX < 0 || posY < 0 || posX >= width || posY >= height)
+            return 0;
+        return field[static_cast<size_t>(posY * width + posX)];
+    };
+    // two pass chessboard distance transform, exact with the 8 neighbours
+    for (auto posY = static_cast<int64_t>(firstY); posY <= static_cast<int64_t>(lastY); ++posY) {
+        for (auto posX = static_cast<int64_t>(firstX); posX <= static_cast<int64_t>(lastX); ++posX) {
+            const auto cell = static_cast<size_t>(posY * width + posX);
+            if (!visible(cell)) {
+                field[cell] = 0;
+                continue;
+            }
+            const uint8_t nearest = std::min({distance(posX - 1, posY), distance(posX - 1, posY - 1), distance(posX, posY - 1), distance(posX + 1, posY - 1)});
+            field[cell]           = std::min<uint8_t>(nearest + 1, Map::maxDistance);
+        }
+    }
+    for (auto posY = static_cast<int64_t>(lastY); posY >= static_cast<int64_t>(firstY); --posY) {
+        for (auto posX = static_cast<int64_t>(lastX); posX >= static_cast<int64_t>(firstX); --posX) {
+            const auto cell = static_cast<size_t>(posY * width + posX);
+            if (field[cell] == 0)
+                continue;
+            const uint8_t nearest = std::min({distance(posX + 1, posY), distance(posX + 1, posY + 1), distance(posX, posY + 1), distance(posX - 1, posY + 1)});
+            field[cell]           = std::min<uint8_t>(field[cell], nearest + 1);
+        }
+    }
+}
+
+}// namespace rc::game::grid
@@ -7,7 +7,15 @@
  */
 
 #include "Map.h"
+#include "Grid.h"
 #include "core/fs/DataFile.h"
+#include "core/fs/MappedFile.h"
+#include "RayWalk.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 
 namespace rc::game {
@@ -46,163 +54,419 @@ static const std::vector<std::string> mapTextures{
         "wood.png",
 };
 
+namespace {
+
+/// Cell coordinate mask inside an occupancy block
+constexpr size_t blockMask = Map::blockSize - 1;
+
+/**
+ * @brief Index of the occupancy block of a cell
+ * @param posX Cell column
+ * @param posY Cell line
+ * @param blockColumns Amount of blocks per line of blocks
+ * @return The block's index
+ */
+size_t blockOf(size_t posX, size_t posY, size_t blockColumns) {
+    return (posY >> Map::blockBits) * blockColumns + (posX >> Map::blockBits);
+}
+
+/**
+ * @brief Check a bit in a bitset
+ * @param bits The bitset
+ * @param index The bit's index
+ * @return True if set
+ */
+bool isSet(const std::vector<uint64_t>& bits, size_t index) {
+    return ((bits[index >> 6U] >> (index & 63U)) & 1U) != 0;
+}
+
+/**
+ * @brief Change a bit in a bitset
+ * @param bits The bitset
+ * @param index The bit's index
+ * @param value The new value
+ */
+void setBit(std::vector<uint64_t>& bits, size_t index, bool value) {
+    const uint64_t mask = uint64_t{1} << (index & 63U);
+    if (value)
+        bits[index >> 6U] |= mask;
+    else
+        bits[index >> 6U] &= ~mask;
+}
+
+}// namespace
+
+bool mapCell::hasTexture() const {
+    return textureId < mapTextures.size();
+}
+
 const graphics::Color& mapCell::getMapColor() const {
-    return mapColors[textureId];
+    return mapColors[hasTexture() ? textureId : 0];
 }
 
 const graphics::Color& mapCell::getRayColor() const {
-    return rayColors[textureId];
+    return rayColors[hasTexture() ? textureId : 0];
 }
 
 const std::string& mapCell::getTextureName() const {
-    return mapTextures[textureId];
+    return mapTextures[hasTexture() ? textureId : 0];
 }
 
-Map::Map(const Map::DataType& data, uint8_t cube) :
-    cubeSize{cube}, mapArray{data} { updateSize(); }
+void CellPlanes::clear() {
+    m_passable.clear();
+    m_visible.clear();
+    m_viewed.clear();
+    m_textureIds.clear();
+}
 
-Map::Map(Map::DataType&& data, uint8_t cube) :
-    cubeSize{cube},
-    mapArray{std::move(data)} { updateSize(); }
+void CellPlanes::reserve(size_t count) {
+    const size_t words = (count + 63) / 64;
+    m_passable.reserve(words);
+    m_visible.reserve(words);
+    m_viewed.reserve(words);
+    m_textureIds.reserve(count);
+}
 
-void Map::reset(uint8_t width, uint8_t height) {
-    // bad size
-    if (width * height == 0) return;
-    mapArray.resize(height);
-    for (LineType& line : mapArray) {
-        line.resize(width);
-        std::fill(line.begin(), line.end(), mapCell{false, false, 2});
+void CellPlanes::assign(size_t count, const mapCell& cell) {
+    const size_t words = (count + 63) / 64;
+    // whole words of the flag, the bits past the last cell are cleared
+    const auto fill = [count, words](std::vector<uint64_t>& plane, bool flag) {
+        plane.assign(words, flag ? ~uint64_t{0} : 0);
+        if (flag && (count & 63U) != 0)
+            plane.back() = (uint64_t{1} << (count & 63U)) - 1;
+    };
+    fill(m_passable, cell.passable);
+    fill(m_visible, cell.visibility);
+    fill(m_viewed, cell.isViewed);
+    m_textureIds.assign(count, cell.textureId);
+}
+
+void CellPlanes::push_back(const mapCell& cell) {
+    const size_t index = size();
+    if ((index & 63U) == 0) {
+        m_passable.push_back(0);
+        m_visible.push_back(0);
+        m_viewed.push_back(0);
     }
+    m_textureIds.push_back(cell.textureId);
+    (*this)[index] = cell;
+}
+
+Map::Map(const Map::DataType& data, CellSizeType cube) :
+    cubeSize{cube} { setMap(data); }
+
+void Map::reset(IndexType width, IndexType height) {
+    // bad size
+    if (width == 0 || height == 0 || width == maxSize || height == maxSize) return;
+    lineCount  = height;
+    lineLength = width;
+    mapArray.assign(lineCount * lineLength, mapCell{false, false, 2});
     PlayerInitialPosition  = {0, 0};
     PlayerInitialDirection = {0, 1};
     updateSize();
 }
 
-void Map::setMap(const DataType& data) {
-    mapArray = data;
-    updateSize();
+void Map::fromLines(const DataType& data) {
+    lineCount  = data.size();
+    lineLength = data.empty() ? 0 : data.front().size();
+    mapArray.clear();
+    if (lineCount >= maxSize || lineLength >= maxSize)
+        return;
+    if (std::any_of(data.begin(), data.end(), [this](const LineType& line) { return line.size() != lineLength; }))
+        return;
+    mapArray.reserve(lineCount * lineLength);
+    for (const LineType& line : data)
+        for (const BaseType& cell : line)
+            mapArray.push_back(cell);
 }
 
-void Map::setMap(DataType&& data) {
-    mapArray = std::move(data);
+void Map::setMap(const DataType& data) {
+    fromLines(data);
     updateSize();
 }
 
 bool Map::isValid() const {
-    if (mapArray.empty()) return false;
-    size_t height = mapArray.front().size();
-    if (height == 0) return false;
-    for (const auto& line : mapArray) {
-        if (line.size() != height) return false;
+    return lineCount != 0 && lineLength != 0 && mapArray.size() == lineCount * lineLength;
+}
+
+std::vector<uint8_t> Map::getTextureIds() const {
+    // only the walls are drawn with their texture, and only the known IDs have one
+    std::array<bool, std::numeric_limits<uint8_t>::max() + 1> used{};
+    const auto textureIds = mapArray.getTexturePlane();
+    for (size_t cell = 0; cell < textureIds.size(); ++cell)
+        if (!mapArray.isVisible(cell))
+            used[textureIds[cell]] = true;
+    std::vector<uint8_t> ids;
+    for (size_t id = 0; id < mapTextures.size(); ++id)
+        if (used[id])
+            ids.push_back(static_cast<uint8_t>(id));
+    return ids;
+}
+
+void Map::setCell(const gridCoordinate& location, const BaseType& cell) {
+    const size_t cellIndex = index(location);
+    mapArray[cellIndex]    = cell;
+    setOpaque(location, !cell.visibility);
+    // the field is only wrong if the cell's kind changed
+    if ((distanceField[cellIndex] == 0) == !cell.visibility)
+        return;
+    const auto first = [](size_t coordinate) { return coordinate - std::min<size_t>(coordinate, maxDistance - 1); };
+    computeDistances(first(location[0]), first(location[1]),
+                     std::min<size_t>(location[0] + maxDistance - 1, lineLength - 1),
+                     std::min<size_t>(location[1] + maxDistance - 1, lineCount - 1));
+}
+
+void Map::updateDistanceField() {
+    distanceField.assign(mapArray.size(), 0);
+    if (isValid())
+        computeDistances(0, 0, lineLength - 1, lineCount - 1);
+}
+
+bool Map::isOpaque(const gridCoordinate& location) const {
+    return isSet(opaqueCells, index(location));
+}
+
+bool Map::isInEmptyBlock(const gridCoordinate& location) const {
+    return !isSet(opaqueBlocks, blockOf(location[0], location[1], blockColumns));
+}
+
+void Map::updateOccupancy() {
+    blockColumns = (lineLength + blockMask) >> blockBits;
+    // the dense level is the visibility plane inverted, word by word
+    const auto visible = mapArray.getVisibilityPlane();
+    opaqueCells.resize(visible.size());
+    std::transform(visible.begin(), visible.end(), opaqueCells.begin(), [](uint64_t word) { return ~word; });
+    if ((mapArray.size() & 63U) != 0)
+        opaqueCells.back() &= (uint64_t{1} << (mapArray.size() & 63U)) - 1;
+    opaqueBlocks.assign((blockColumns * ((lineCount + blockMask) >> blockBits) + 63) / 64, 0);
+    if (!isValid())
+        return;
+    for (size_t posY = 0; posY < lineCount; ++posY)
+        for (size_t posX = 0; posX < lineLength; ++posX)
+            if (isSet(opaqueCells, posY * lineLength + posX))
+                setBit(opaqueBlocks, blockOf(posX, posY, blockColumns), true);
+    // the cells past the border of the last blocks stop the rays
+    if ((lineLength & blockMask) != 0)
+        for (size_t posY = 0; posY < lineCount; posY += blockSize)
+            setBit(opaqueBlocks, blockOf(lineLength - 1, posY, blockColumns), true);
+    if ((lineCount & blockMask) != 0)
+        for (size_t posX = 0; posX < lineLength; posX += blockSize)
+            setBit(opaqueBlocks, blockOf(posX, lineCount - 1, blockColumns), true);
+}
+
+void Map::setOpaque(const gridCoordinate& location, bool opaque) {
+    setBit(opaqueCells, index(location), opaque);
+    if (opaque) {
+        setBit(opaqueBlocks, blockOf(location[0], location[1], blockColumns), true);
+        return;
     }
-    return true;
+    const size_t firstX = location[0] & ~blockMask;
+    const size_t firstY = location[1] & ~blockMask;
+    const size_t lastX  = std::min(firstX + blockSize, lineLength);
+    const size_t lastY  = std::min(firstY + blockSize, lineCount);
+    // a block crossing the map's border is never empty
+    bool blockOpaque = lastX - firstX < blockSize || lastY - firstY < blockSize;
+    for (size_t posY = firstY; posY < lastY && !blockOpaque; ++posY)
+        for (size_t posX = firstX; posX < lastX && !blockOpaque; ++posX)
+            blockOpaque = isSet(opaqueCells, posY * lineLength + posX);
+    setBit(opaqueBlocks, blockOf(location[0], location[1], blockColumns), blockOpaque);
 }
 
-Map::BaseType& Map::at(const gridCoordinate& location) {
-    return mapArray[location[1]][location[0]];
+void Map::computeDistances(size_t firstX, size_t firstY, size_t lastX, size_t lastY) {
+    grid::computeDistances(distanceField, lineLength, lineCount, firstX, firstY, lastX, lastY, [this](size_t cell) { return mapArray.isVisible(cell); });
 }
 
-const Map::BaseType& Map::at(const gridCoordinate& location) const {
-    return mapArray[location[1]][location[0]];
+Map::BaseType Map::at(const gridCoordinate& location) const {
+    return mapArray[index(location)];
 }
 
-Map::rayCastResult Map::castRay(const worldCoordinates& from, const worldCoordinates& direction) const {
-    //gridCoordinate playerCell = whichCell(from);
-    // check for vertical line
-    double verticalDistance = -1;
-    worldCoordinates verticalPoint{from};
-    double verticalCellRatio = 0;
-    if (std::abs(direction[0]) > 0.001)  {
-        // Intersection with verticals
-        worldCoordinates verticalOffset{};
-        verticalOffset = direction / std::abs(direction[0]);
-        verticalPoint  = from + math::geometry::Vectf{math::sign(direction[0]) * 0.001, 0.0} + verticalOffset * std::abs((static_cast<int32_t>(from[0] / cubeSize) + math::heaviside(direction[0])) * cubeSize - from[0]);
-        verticalOffset *= cubeSize;
-        gridCoordinate verticalCell = whichCell(verticalPoint);
-        while (isInVisible(verticalCell)) {
-            verticalPoint += verticalOffset;
-            verticalCell = whichCell(verticalPoint);
-        }
-        if (isIn(verticalCell))
-            verticalDistance = (verticalPoint - from).lengthSQ();
-        verticalCellRatio = std::abs(verticalPoint[1] - (verticalCell[1] + math::heaviside(-direction[0])) * cubeSize);
+namespace {
+
+/**
+ * @brief The map's cells, as seen by the ray walk
+ */
+struct MapCells {
+    const std::vector<uint8_t>& distances;///< The distance field of the cells
+    const std::vector<uint64_t>& nonEmpty;///< The blocks with a cell stopping the rays, one bit per block
+    int64_t columns;                      ///< Cells per line
+    int64_t lines;                        ///< Amount of lines
+    size_t blockColumns;                  ///< Blocks per line of blocks
+
+    [[nodiscard]] bool isOutside(const walk::RayWalk& walk) const {
+        return walk.cellX < 0 || walk.cellY < 0 || walk.cellX >= columns || walk.cellY >= lines;
     }
-    // check for horizontal line
-    double horizontalDistance = -1;
-    worldCoordinates horizontalPoint{from};
-    double horizontalCellRatio = 0;
-    if (std::abs(direction[1]) > 0.001) {
-        // Intersection with verticals
-        worldCoordinates horizontalOffset{};
-        horizontalOffset = direction / std::abs(direction[1]);
-        horizontalPoint    = from + math::geometry::Vectf{0.0, math::sign(direction[1]) * 0.001} + horizontalOffset * std::abs((static_cast<int32_t>(from[1] / cubeSize) + math::heaviside(direction[1])) * cubeSize - from[1]);
-        horizontalOffset *= cubeSize;
-        gridCoordinate horizontalCell = whichCell(horizontalPoint);
-        while (isInVisible(horizontalCell)) {
-            horizontalPoint += horizontalOffset;
-            horizontalCell = whichCell(horizontalPoint);
-        }
-        if (isIn(horizontalCell))
-            horizontalDistance = (horizontalPoint - from).lengthSQ();
-        horizontalCellRatio = std::abs(horizontalPoint[0] - (horizontalCell[0] + math::heaviside(direction[1])) * cubeSize);
+    [[nodiscard]] uint8_t distance(const walk::RayWalk& walk) const { return distances[static_cast<size_t>(walk.idx)]; }
+    [[nodiscard]] bool isInEmptyBlock(const walk::RayWalk& walk) const {
+        return !isSet(nonEmpty, blockOf(static_cast<size_t>(walk.cellX), static_cast<size_t>(walk.cellY), blockColumns));
     }
-    if (verticalDistance < 0)
-        return {std::sqrt(horizontalDistance), horizontalPoint, false, horizontalCellRatio};
-    if (horizontalDistance < 0)
-        return {std::sqrt(verticalDistance), verticalPoint, true, verticalCellRatio};
-    if (horizontalDistance < verticalDistance)
-        return {std::sqrt(horizontalDistance), horizontalPoint, false, horizontalCellRatio};
-    return {std::sqrt(verticalDistance), verticalPoint, true, verticalCellRatio};
+};
+
+}// namespace
+
+Map::rayCastResult Map::castRay(const worldCoordinates& from, const worldCoordinates& direction) const {
+    const auto columns = static_cast<int64_t>(lineLength);
+    // set by startWalk, then kept in registers by the inlined stepping
+    walk::RayWalk walk;
+    if (!walk::startWalk(from, direction, cubeSize, columns, walk))
+        return {0, from, false, 0};
+    MapCells cells{distanceField, opaqueBlocks, columns, static_cast<int64_t>(lineCount), blockColumns};
+    walk::walkToWall(walk, columns, cells);
+    return walk::hitResult(walk, from, direction, cubeSize);
 }
 
 Map::gridCoordinate Map::whichCell(const worldCoordinates& from) const {
-    gridCoordinate result;
-    result[0] = static_cast<unsigned char>(static_cast<uint64_t>(from[0]) / cubeSize);
-    result[1] = static_cast<unsigned char>(static_cast<uint64_t>(from[1]) / cubeSize);
-    return result;
+    return grid::whichCell(from, cubeSize);
 }
 
 bool Map::isIn(const worldCoordinates& from) const {
-    return from[0] >= 0 && from[0] <= maxWidth && from[1] >= 0 && from[1] <= maxHeight;
+    return grid::isIn(from, lineLength, lineCount, cubeSize);
 }
 
 bool Map::isIn(const gridCoordinate& from) const {
-    return from[0] < width() && from[1] < height();
+    return grid::isIn(from, lineLength, lineCount);
 }
 
 bool Map::isInPassable(const worldCoordinates& from) const {
-    return isIn(from) && at(whichCell(from)).passable;
+    return isIn(from) && mapArray.isPassable(index(whichCell(from)));
 }
 
 bool Map::isInPassable(const Map::gridCoordinate& from) const {
-    return isIn(from) && at(from).passable;
+    return isIn(from) && mapArray.isPassable(index(from));
 }
 
 bool Map::isInVisible(const worldCoordinates& from) const {
-    return isIn(from) && at(whichCell(from)).visibility;
+    return isIn(from) && mapArray.isVisible(index(whichCell(from)));
 }
 
 bool Map::isInVisible(const Map::gridCoordinate& from) const {
-    return isIn(from) && at(from).visibility;
+    return isIn(from) && mapArray.isVisible(index(from));
 }
 
 Map::worldCoordinates Map::possibleMove(const worldCoordinates& Start, const worldCoordinates& Expected) const {
-    if (isInPassable(Start + Expected))
-        return Expected;
-    if (isInPassable(Start + worldCoordinates{Expected[0], 0.0}))
-        return {Expected[0], 0.0};
-    if (isInPassable(Start + worldCoordinates{0.0, Expected[1]}))
-        return {0.0, Expected[1]};
-    return worldCoordinates();
+    return grid::possibleMove(Start, Expected, [this](const worldCoordinates& point) { return isInPassable(point); });
 }
 
 void Map::updateSize() {
-    maxWidth  = static_cast<double>(width() * cubeSize);
-    maxHeight = static_cast<double>(height() * cubeSize);
+    updateDistanceField();
+    updateOccupancy();
+}
+
+namespace {
+
+/// First bytes of the binary map files
+constexpr std::array<uint8_t, 4> binaryMagic{'R', 'C', 'M', 'P'};
+/// Extension of the json map files
+constexpr const char* jsonExtension = ".map";
+/// Extension of the binary map files
+constexpr const char* binaryExtension = ".rcmap";
+
+/**
+ * @brief Append a value in little endian
+ * @tparam T Value's type (integer or double)
+ * @param bytes The output
+ * @param value The value
+ */
+template<class T>
+void writeValue(std::vector<uint8_t>& bytes, T value) {
+    using UnsignedType = std::conditional_t<sizeof(T) == 8, uint64_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint16_t>>;
+    auto raw           = std::bit_cast<UnsignedType>(value);
+    if constexpr (std::endian::native == std::endian::big)
+        raw = std::byteswap(raw);
+    const auto first = bytes.size();
+    bytes.resize(first + sizeof(raw));
+    std::memcpy(bytes.data() + first, &raw, sizeof(raw));
+}
+
+/**
+ * @brief Read a little endian value
+ * @tparam T Value's type (integer or double)
+ * @param bytes The input, large enough
+ * @param offset Position of the value, moved after it
+ * @return The value
+ */
+template<class T>
+T readValue(std::span<const uint8_t> bytes, size_t& offset) {
+    using UnsignedType = std::conditional_t<sizeof(T) == 8, uint64_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint16_t>>;
+    UnsignedType raw;
+    std::memcpy(&raw, bytes.data() + offset, sizeof(raw));
+    offset += sizeof(raw);
+    if constexpr (std::endian::native == std::endian::big)
+        raw = std::byteswap(raw);
+    return std::bit_cast<T>(raw);
+}
+
+/**
+ * @brief Check if bytes start like a binary map
+ * @param bytes The bytes
+ * @return True if binary map
+ */
+bool isBinaryMap(std::span<const uint8_t> bytes) {
+    return bytes.size() >= binaryMagic.size() && std::equal(binaryMagic.begin(), binaryMagic.end(), bytes.begin());
+}
+
+}// namespace
+
+bool Map::readBinaryHeader(std::span<const uint8_t> data, BinaryHeader& header) {
+    if (data.size() < binaryHeaderSize || !isBinaryMap(data))
+        return false;
+    size_t offset = binaryMagic.size();
+    if (readValue<uint16_t>(data, offset) != binaryVersion)
+        return false;
+    const auto cube   = readValue<uint16_t>(data, offset);
+    const auto lines  = readValue<uint32_t>(data, offset);
+    const auto length = readValue<uint32_t>(data, offset);
+    if (cube == 0 || lines >= maxSize || length >= maxSize || data.size() - binaryHeaderSize != static_cast<size_t>(lines) * length)
+        return false;
+    const double posX = readValue<double>(data, offset);
+    const double posY = readValue<double>(data, offset);
+    const double dirX = readValue<double>(data, offset);
+    const double dirY = readValue<double>(data, offset);
+    header            = {cube, lines, length, {posX, posY}, {dirX, dirY}};
+    return true;
+}
+
+bool Map::fromBinary(std::span<const uint8_t> data) {
+    lineCount  = 0;
+    lineLength = 0;
+    mapArray.clear();
+    updateSize();
+    BinaryHeader header;
+    if (!readBinaryHeader(data, header))
+        return false;
+    cubeSize               = header.cubeSize;
+    PlayerInitialPosition  = header.playerStart;
+    PlayerInitialDirection = header.playerStartDir;
+    lineCount              = header.lineCount;
+    lineLength             = header.lineLength;
+    const auto cells       = data.subspan(binaryHeaderSize);
+    mapArray.generate(cells.size(), [&cells](size_t cell) { return mapCell::fromByte(cells[cell]); });
+    updateSize();
+    return true;
+}
+
+std::vector<uint8_t> Map::toBinary() const {
+    std::vector<uint8_t> data(binaryMagic.begin(), binaryMagic.end());
+    data.reserve(binaryHeaderSize + mapArray.size());
+    writeValue(data, binaryVersion);
+    writeValue(data, cubeSize);
+    writeValue(data, static_cast<uint32_t>(lineCount));
+    writeValue(data, static_cast<uint32_t>(lineLength));
+    writeValue(data, PlayerInitialPosition[0]);
+    writeValue(data, PlayerInitialPosition[1]);
+    writeValue(data, PlayerInitialDirection[0]);
+    writeValue(data, PlayerInitialDirection[1]);
+    for (size_t cell = 0; cell < mapArray.size(); ++cell)
+        data.push_back(mapArray[cell].toByte());
+    return data;
 }
 
 void Map::loadFromFile(const std::string& mapName) {
     auto file = std::filesystem::path(mapName);
+    const core::fs::MappedFile mapped(file);
+    if (isBinaryMap(mapped.data())) {
+        fromBinary(mapped.data());
+        return;
+    }
     std::ifstream jStream(file);
     if (!jStream.is_open()) return;
     auto data = nlohmann::json::parse(jStream);
@@ -210,31 +474,47 @@ void Map::loadFromFile(const std::string& mapName) {
     fromJson(data);
 }
 
-void Map::saveToFile(const std::string& mapName) {
-    nlohmann::json data = toJson();
+void Map::saveToFile(const std::string& mapName, FileFormat format) {
     core::fs::DataFile file;
     file.setPath(std::filesystem::path(mapName));
-    file.writeJson(data);
+    if (format == FileFormat::Binary)
+        file.writeBinary(toBinary());
+    else
+        file.writeJson(toJson());
 }
 
 void Map::loadFromData(const std::string& mapName) {
-    core::fs::DataFile file;
-    file.setPath(std::filesystem::path("maps") / (mapName + ".map"));
-    auto data = file.readJson();
+    const core::fs::DataFile binary(std::filesystem::path("maps") / (mapName + binaryExtension));
+    const core::fs::DataFile json(std::filesystem::path("maps") / (mapName + jsonExtension));
+    if (isBinaryCurrent(mapName)) {
+        if (fromBinary(core::fs::MappedFile(binary.getFullPath()).data()) || !json.exists())
+            return;
+    }
+    auto data = json.readJson();
     fromJson(data);
 }
 
-void Map::saveToData(const std::string& mapName) {
-    nlohmann::json data = toJson();
+bool Map::isBinaryCurrent(const std::string& mapName) {
+    const core::fs::DataFile binary(std::filesystem::path("maps") / (mapName + binaryExtension));
+    const core::fs::DataFile json(std::filesystem::path("maps") / (mapName + jsonExtension));
+    if (!binary.exists())
+        return false;
+    return !json.exists() || std::filesystem::last_write_time(binary.getFullPath()) >= std::filesystem::last_write_time(json.getFullPath());
+}
+
+void Map::saveToData(const std::string& mapName, FileFormat format) {
     core::fs::DataFile file;
-    file.setPath(std::filesystem::path("maps") / (mapName + ".map"));
-    file.writeJson(data);
+    file.setPath(std::filesystem::path("maps") / (mapName + (format == FileFormat::Binary ? binaryExtension : jsonExtension)));
+    if (format == FileFormat::Binary)
+        file.writeBinary(toBinary());
+    else
+        file.writeJson(toJson());
 }
 
 void Map::fromJson(const nlohmann::json& data) {
     [[maybe_unused]] const uint8_t version = data["version"];// but still to be read when map will contain more data
     cubeSize                         = data["cubeSize"];
-    mapArray                         = data["cells"];
+    fromLines(data["cells"].get<DataType>());
     PlayerInitialPosition            = data["playerStart"];
     PlayerInitialDirection           = data["playerStartDir"];
     updateSize();
@@ -246,7 +526,14 @@ nlohmann::json Map::toJson() const {
     data["width"]          = width();
     data["height"]         = height();
     data["cubeSize"]       = cubeSize;
-    data["cells"]          = mapArray;
+    data["cells"]          = nlohmann::json::array();
+    for (size_t line = 0; line < lineCount; ++line) {
+        LineType cells;
+        cells.reserve(lineLength);
+        for (size_t cell = line * lineLength; cell < (line + 1) * lineLength; ++cell)
+            cells.push_back(mapArray[cell]);
+        data["cells"].push_back(cells);
+    }
     data["playerStart"]    = PlayerInitialPosition;
     data["playerStartDir"] = PlayerInitialDirection;
     return data;
@@ -10,10 +10,19 @@
 
 #include "graphics/Color.h"
 #include "math/geometry/Vector2.h"
+#include <algorithm>
+#include <limits>
+#include <span>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
+#ifndef RAYCAST_MAP_INDEX_BITS
+/// Bit width of the map grid indexes (16 or 32), defined by the build system
+#define RAYCAST_MAP_INDEX_BITS 16
+#endif
+
 /**
  * @brief Namespace for game items
  */
@@ -27,6 +36,11 @@ struct mapCell {
     bool passable;    ///< if player can pass through
     bool visibility;  ///< if player can see through
     uint8_t textureId;///< wall texture ID (color)
+    /**
+     * @brief Check if the texture ID has a texture and colors, the others use the ones of ID 0
+     * @return True if the ID is known
+     */
+    [[nodiscard]] bool hasTexture() const;
     /**
      * @brief Get the associated color for map and 3D view
      * @return the color
@@ -42,6 +56,17 @@ struct mapCell {
      * @return Texture's name
      */
     const std::string& getTextureName() const;
+    /**
+     * @brief Pack the cell in one byte: passable (bit 7), visibility (bit 6), texture ID (bits 0-5)
+     * @return The packed cell
+     */
+    [[nodiscard]] uint8_t toByte() const { return static_cast<uint8_t>((passable * 0b10000000) | (visibility * 0b01000000) | (textureId & 0b00111111)); }
+    /**
+     * @brief Unpack a cell
+     * @param packed The packed cell
+     * @return The cell
+     */
+    [[nodiscard]] static mapCell fromByte(uint8_t packed) { return {(packed & 0b10000000) == 0b10000000, (packed & 0b01000000) == 0b01000000, static_cast<uint8_t>(packed & 0b00111111)}; }
     /**
      * @brief Comparison operator
      * @return True if equal
@@ -62,8 +87,7 @@ struct mapCell {
  * @param mCell The mapCell to serialize
  */
 inline void to_json(nlohmann::json& jso, const mapCell& mCell) {
-    const uint8_t result = (mCell.passable * 0b10000000) | (mCell.visibility * 0b01000000) | (mCell.textureId & 0b00111111);
-    jso            = nlohmann::json{result};
+    jso = nlohmann::json{mCell.toByte()};
 }
 /**
  * @brief Deserialize this object from json
@@ -72,11 +96,267 @@ inline void to_json(nlohmann::json& jso, const mapCell& mCell) {
  */
 inline void from_json(const nlohmann::json& jso, mapCell& mCell) {
     const uint8_t result = jso.at(0);
-    mCell.textureId  = result & 0b00111111;
-    mCell.visibility = (result & 0b01000000) == 0b01000000;
-    mCell.passable   = (result & 0b10000000) == 0b10000000;
+    const mapCell cell   = mapCell::fromByte(result);
+    mCell.textureId      = cell.textureId;
+    mCell.visibility     = cell.visibility;
+    mCell.passable       = cell.passable;
 }
 
+/**
+ * @brief Class CellPlanes
+ *
+ * Cells stored by planes: one bit per cell for each flag, one byte per cell for the texture ID,
+ * all in the same cell order. A query reads only the plane it needs (movement the passable bits,
+ * rays the visibility bits). Cells are read by value, and changed through a Reference that
+ * has the fields of a mapCell.
+ */
+class CellPlanes {
+public:
+    /**
+     * @brief Reference to a flag of a cell
+     */
+    class FlagReference {
+    public:
+        /**
+         * @brief Constructor
+         * @param word The plane's word holding the flag
+         * @param mask The flag's bit in the word
+         */
+        FlagReference(uint64_t& word, uint64_t mask) :
+            m_word{&word}, m_mask{mask} {}
+        /**
+         * @brief Default copy constructor
+         */
+        FlagReference(const FlagReference&) = default;
+        /**
+         * @brief Change the flag
+         * @param value The new value
+         * @return this
+         */
+        FlagReference& operator=(bool value) {
+            *m_word = value ? *m_word | m_mask : *m_word & ~m_mask;
+            return *this;
+        }
+        /**
+         * @brief Copy the value of another flag
+         * @param other The flag to copy
+         * @return this
+         */
+        FlagReference& operator=(const FlagReference& other) { return *this = static_cast<bool>(other); }
+        /**
+         * @brief Read the flag
+         */
+        operator bool() const { return (*m_word & m_mask) != 0; }
+
+    private:
+        /// The plane's word holding the flag
+        uint64_t* m_word;
+        /// The flag's bit in the word
+        uint64_t m_mask;
+    };
+    /**
+     * @brief Reference to a cell, with the fields of a mapCell
+     */
+    class Reference {
+    public:
+        FlagReference passable;  ///< if player can pass through
+        FlagReference visibility;///< if player can see through
+        uint8_t& textureId;      ///< wall texture ID (color)
+        FlagReference isViewed;  ///< if the player has seen this wall
+        /**
+         * @brief Constructor
+         * @param planes The storage
+         * @param index The cell's index
+         */
+        Reference(CellPlanes& planes, size_t index) :
+            passable{planes.m_passable[index >> 6U], uint64_t{1} << (index & 63U)},
+            visibility{planes.m_visible[index >> 6U], uint64_t{1} << (index & 63U)},
+            textureId{planes.m_textureIds[index]},
+            isViewed{planes.m_viewed[index >> 6U], uint64_t{1} << (index & 63U)} {}
+        /**
+         * @brief Default copy constructor
+         */
+        Reference(const Reference&) = default;
+        /**
+         * @brief Change the whole cell
+         * @param cell The new cell
+         * @return this
+         */
+        Reference& operator=(const mapCell& cell) {
+            passable   = cell.passable;
+            visibility = cell.visibility;
+            textureId  = cell.textureId;
+            isViewed   = cell.isViewed;
+            return *this;
+        }
+        /**
+         * @brief Copy the value of another cell
+         * @param other The cell to copy
+         * @return this
+         */
+        Reference& operator=(const Reference& other) { return *this = static_cast<mapCell>(other); }
+        /**
+         * @brief Read the whole cell
+         */
+        operator mapCell() const { return {passable, visibility, textureId, isViewed}; }
+        /**
+         * @brief Get the associated color for map and 3D view
+         * @return the color
+         */
+        [[nodiscard]] const graphics::Color& getMapColor() const { return static_cast<mapCell>(*this).getMapColor(); }
+        /**
+         * @brief Get the associated color for ray on map
+         * @return the color
+         */
+        [[nodiscard]] const graphics::Color& getRayColor() const { return static_cast<mapCell>(*this).getRayColor(); }
+        /**
+         * @brief Get the name of the textue
+         * @return Texture's name
+         */
+        [[nodiscard]] const std::string& getTextureName() const { return static_cast<mapCell>(*this).getTextureName(); }
+    };
+
+    /**
+     * @brief Get the amount of cells
+     * @return Amount of cells
+     */
+    [[nodiscard]] size_t size() const { return m_textureIds.size(); }
+    /**
+     * @brief Check if there is no cell
+     * @return True if empty
+     */
+    [[nodiscard]] bool empty() const { return m_textureIds.empty(); }
+    /**
+     * @brief Remove all the cells
+     */
+    void clear();
+    /**
+     * @brief Reserve the memory for an amount of cells
+     * @param count Amount of cells
+     */
+    void reserve(size_t count);
+    /**
+     * @brief Replace the cells by copies of one
+     * @param count Amount of cells
+     * @param cell The cell to copy
+     */
+    void assign(size_t count, const mapCell& cell);
+    /**
+     * @brief Add a cell at the end
+     * @param cell The new cell
+     */
+    void push_back(const mapCell& cell);
+    /**
+     * @brief Replace the cells by generated ones
+     * @tparam Generator Callable as generator(index), the cell of an index
+     * @param count Amount of cells
+     * @param generator The cells' generator
+     *
+     * The flags are gathered 64 cells at a time, and each plane's word written once.
+     */
+    template<class Generator>
+    void generate(size_t count, Generator&& generator) {
+        const size_t words = (count + 63) / 64;
+        m_passable.resize(words);
+        m_visible.resize(words);
+        m_viewed.resize(words);
+        m_textureIds.resize(count);
+        for (size_t word = 0; word < words; ++word) {
+            uint64_t passable = 0;
+            uint64_t visible  = 0;
+            uint64_t viewed   = 0;
+            for (size_t index = word * 64; index < std::min(count, word * 64 + 64); ++index) {
+                const mapCell cell = generator(index);
+                const size_t bit   = index & 63U;
+                passable |= uint64_t{cell.passable} << bit;
+                visible |= uint64_t{cell.visibility} << bit;
+                viewed |= uint64_t{cell.isViewed} << bit;
+                m_textureIds[index] = cell.textureId;
+            }
+            m_passable[word] = passable;
+            m_visible[word]  = visible;
+            m_viewed[word]   = viewed;
+        }
+    }
+
+    /**
+     * @brief Read a cell
+     * @param index Cell's index
+     * @return The cell
+     */
+    [[nodiscard]] mapCell operator[](size_t index) const { return {isPassable(index), isVisible(index), m_textureIds[index], isViewed(index)}; }
+    /**
+     * @brief Access to a cell
+     * @param index Cell's index
+     * @return Reference to the cell
+     */
+    [[nodiscard]] Reference operator[](size_t index) { return {*this, index}; }
+    /**
+     * @brief Check if player can pass through a cell
+     * @param index Cell's index
+     * @return The passable flag
+     */
+    [[nodiscard]] bool isPassable(size_t index) const { return isSet(m_passable, index); }
+    /**
+     * @brief Check if player can see through a cell
+     * @param index Cell's index
+     * @return The visibility flag
+     */
+    [[nodiscard]] bool isVisible(size_t index) const { return isSet(m_visible, index); }
+    /**
+     * @brief Check if the player has seen a cell
+     * @param index Cell's index
+     * @return The viewed flag
+     */
+    [[nodiscard]] bool isViewed(size_t index) const { return isSet(m_viewed, index); }
+    /**
+     * @brief Get the texture ID of a cell
+     * @param index Cell's index
+     * @return The texture ID
+     */
+    [[nodiscard]] uint8_t getTextureId(size_t index) const { return m_textureIds[index]; }
+    /**
+     * @brief Get the visibility plane
+     * @return One bit per cell, 64 cells per word (the bits past the last cell are cleared)
+     */
+    [[nodiscard]] std::span<const uint64_t> getVisibilityPlane() const { return m_visible; }
+    /**
+     * @brief Get the texture plane
+     * @return One texture ID per cell
+     */
+    [[nodiscard]] std::span<const uint8_t> getTexturePlane() const { return m_textureIds; }
+    /**
+     * @brief Get the memory used by the planes
+     * @return Size in bytes
+     */
+    [[nodiscard]] size_t getMemoryUsage() const {
+        return (m_passable.size() + m_visible.size() + m_viewed.size()) * sizeof(uint64_t) + m_textureIds.size();
+    }
+    /**
+     * @brief Comparison operator
+     * @return True if equal
+     */
+    [[nodiscard]] bool operator==(const CellPlanes&) const = default;
+
+private:
+    /**
+     * @brief Read a bit of a plane
+     * @param plane The plane
+     * @param index Cell's index
+     * @return The bit
+     */
+    [[nodiscard]] static bool isSet(const std::vector<uint64_t>& plane, size_t index) { return ((plane[index >> 6U] >> (index & 63U)) & 1U) != 0; }
+
+    /// Passable flags
+    std::vector<uint64_t> m_passable;
+    /// Visibility flags
+    std::vector<uint64_t> m_visible;
+    /// Viewed flags
+    std::vector<uint64_t> m_viewed;
+    /// Texture IDs
+    std::vector<uint8_t> m_textureIds;
+};
+
 /**
  * @brief Class Map
  */
@@ -86,10 +366,22 @@ public:
     using BaseType = mapCell;
     /// Map line's type
     using LineType = std::vector<BaseType>;
-    /// Map data's type
+    /// Map data's type, as lines of cells (used to build maps)
     using DataType = std::vector<LineType>;
+    /// Map storage's type: all the lines one after the other (row-major), by planes
+    using StorageType = CellPlanes;
     /// Index's type in map data
-    using IndexType = uint8_t;
+    using IndexType = std::conditional_t<RAYCAST_MAP_INDEX_BITS == 32, uint32_t, uint16_t>;
+    /// Cell size's type
+    using CellSizeType = uint16_t;
+    /// Largest map size, the max index is kept as the 'outside' cell
+    static constexpr size_t maxSize = std::numeric_limits<IndexType>::max();
+    /// Distances of the distance field are clamped to this
+    static constexpr uint8_t maxDistance = 32;
+    /// Bits of a cell coordinate inside its occupancy block
+    static constexpr size_t blockBits = 3;
+    /// Occupancy block side in cells: the cells of a block fit in one 64 bits word
+    static constexpr size_t blockSize = size_t{1} << blockBits;
     /// Grid coordinate's type
     using gridCoordinate = math::geometry::Vector2<IndexType>;
     /// World coordinate's type
@@ -128,21 +420,14 @@ public:
      * @param h height
      * @param cube Cube size
      */
-    Map(IndexType w, IndexType h, uint8_t cube = 64) :
+    Map(IndexType w, IndexType h, CellSizeType cube = 64) :
         cubeSize{cube} { reset(w, h); }
     /**
      * @brief Constructor by Data
-     * @param data The raw data to copy
-     * @param cube The cube size
-     */
-    Map(const DataType& data, uint8_t cube = 64);
-
-    /**
-     * @brief Constructor by Data
-     * @param data The raw data to copy
+     * @param data The lines of cells, unpacked into the cell planes
      * @param cube The cube size
      */
-    Map(DataType&& data, uint8_t cube = 64);
+    Map(const DataType& data, CellSizeType cube = 64);
 
     /**
      * @brief Set the map dat
@@ -151,61 +436,105 @@ public:
      * Will update th width and height according to the data
      */
     void setMap(const DataType& data);
+
     /**
-     * @brief Set the map dat
-     * @param data The map data
+     * @brief Get the raw map data
+     * @return Map data, line after line, stride() cells per line
      *
-     * Will update th width and height according to the data
+     * Changing the see-through state of cells through this requires an updateDistanceField()
+     * and an updateOccupancy().
      */
-    void setMap(DataType&& data);
-
+    StorageType& getMapData() { return mapArray; }
     /**
      * @brief Get the raw map data
-     * @return Map data
+     * @return Map data, line after line, stride() cells per line
+     */
+    [[nodiscard]] const StorageType& getMapData() const { return mapArray; }
+    /**
+     * @brief Get the amount of cells in one line of the storage
+     * @return The stride
      */
-    DataType& getMapData() { return mapArray; }
+    [[nodiscard]] size_t stride() const { return lineLength; }
 
     /**
      * @brief Access to map value at the coordinate
      * @param location coordinates
      * @return The local map data
      */
-    BaseType& operator()(const gridCoordinate& location) { return at(location); }
+    BaseType operator()(const gridCoordinate& location) const { return at(location); }
+
     /**
      * @brief Access to map value at the coordinate
      * @param location coordinates
      * @return The local map data
      */
-    const BaseType& operator()(const gridCoordinate& location) const { return at(location); }
+    [[nodiscard]] BaseType at(const gridCoordinate& location) const;
 
     /**
-     * @brief Access to map value at the coordinate
-     * @param location coordinates
-     * @return The local map data
+     * @brief Change a cell, and update the occupancy and the distance field around it
+     * @param location Coordinates
+     * @param cell The new cell
+     *
+     * All the edits of the cells go through here (or through the raw data, followed by the
+     * updates of the whole map).
      */
-    BaseType& at(const gridCoordinate& location);
+    void setCell(const gridCoordinate& location, const BaseType& cell);
     /**
-     * @brief Access to map value at the coordinate
-     * @param location coordinates
-     * @return The local map data
+     * @brief Mark a cell as seen by the player, for the map display
+     * @param location Coordinates
+     */
+    void setViewed(const gridCoordinate& location) { mapArray[index(location)].isViewed = true; }
+    /**
+     * @brief Get the distance from a cell to the nearest wall
+     * @param location Coordinates
+     * @return Chebyshev distance, in cells, to the nearest cell not see-through or outside the map (up to maxDistance)
+     */
+    [[nodiscard]] uint8_t getDistance(const gridCoordinate& location) const { return distanceField[index(location)]; }
+    /**
+     * @brief Compute the distance field of the whole map
+     *
+     * Done on load, needed only after changes in the raw data.
      */
-    [[nodiscard]] const BaseType& at(const gridCoordinate& location) const;
+    void updateDistanceField();
+    /**
+     * @brief Check if a cell stops the rays, in the occupancy bitmaps
+     * @param location Coordinates
+     * @return True if not see-through
+     */
+    [[nodiscard]] bool isOpaque(const gridCoordinate& location) const;
+    /**
+     * @brief Check if the occupancy block of a cell has no cell stopping the rays
+     * @param location Coordinates of a cell in the block
+     * @return True if all the block's cells are see-through and in the map
+     */
+    [[nodiscard]] bool isInEmptyBlock(const gridCoordinate& location) const;
+    /**
+     * @brief Compute the occupancy bitmaps of the whole map
+     *
+     * Done on load, needed only after changes in the raw data.
+     */
+    void updateOccupancy();
 
     /**
      * @brief Get the map's width
      * @return Map's width
      */
-    [[nodiscard]] size_t width() const { return mapArray.size(); }
+    [[nodiscard]] size_t width() const { return lineCount; }
     /**
      * @brief Get the map's height
      * @return Map's height
      */
-    [[nodiscard]] size_t height() const { return mapArray.empty() ? 0 : mapArray.front().size(); }
+    [[nodiscard]] size_t height() const { return lineLength; }
     /**
      * @brief Check the map validity
      * @return True if map valid.
      */
     [[nodiscard]] bool isValid() const;
+    /**
+     * @brief Get the texture IDs used by the walls, to load their textures with the map
+     * @return The IDs that have a texture, in increasing order
+     */
+    [[nodiscard]] std::vector<uint8_t> getTextureIds() const;
 
     /**
      * @brief Ray casting result
@@ -221,13 +550,19 @@ public:
      * @param from Starting point
      * @param direction Ray's direction
      * @return Hit data
+     *
+     * Single pass grid traversal (Amanatides & Woo): the ray steps from cell to cell
+     * with integer indexes until it enters a cell that is not see-through.
+     * Leaving the map stops the ray on the map border. In empty space, the ray leaps over the
+     * cells closer than the nearest wall in the distance field, or to the end of its occupancy
+     * block if empty and farther, to the same hit.
      */
     [[nodiscard]] rayCastResult castRay(const worldCoordinates& from, const worldCoordinates& direction) const;
 
     /**
      * @brief Determine the cell where the point lies.
      * @param from The point to check
-     * @return The cell
+     * @return The cell, coordinates outside the map give the max index
      */
     [[nodiscard]] gridCoordinate whichCell(const worldCoordinates& from) const;
     /**
@@ -273,17 +608,17 @@ public:
      * @brief Get the cube's size
      * @return Cube's size
      */
-    [[nodiscard]] uint8_t getCellSize() const { return cubeSize; }
+    [[nodiscard]] CellSizeType getCellSize() const { return cubeSize; }
     /**
      * @brief Get the full pixel width of the map
      * @return Pixel width of the map
      */
-    [[nodiscard]] uint32_t fullWidth() const { return static_cast<uint32_t>(width()) * cubeSize; }
+    [[nodiscard]] uint64_t fullWidth() const { return static_cast<uint64_t>(width()) * cubeSize; }
     /**
      * @brief Get the full pixel height of the map
      * @return Pixel height of the map
      */
-    [[nodiscard]] uint32_t fullHeight() const { return static_cast<uint32_t>(height()) * cubeSize; }
+    [[nodiscard]] uint64_t fullHeight() const { return static_cast<uint64_t>(height()) * cubeSize; }
 
     /**
      * @brief Check and modify the expected move according to map constrains
@@ -310,25 +645,83 @@ public:
 
 
     /**
-     * @brief load a map
+     * @brief Map file formats
+     */
+    enum struct FileFormat {
+        Json,  ///< Json text (.map), for edition and exchange
+        Binary,///< Packed binary (.rcmap), for fast loading
+    };
+    /// Version of the binary format
+    static constexpr uint16_t binaryVersion = 1;
+    /// Size of the binary format's header
+    static constexpr size_t binaryHeaderSize = 48;
+
+    /**
+     * @brief load a map from the newest of its binary and json files
      * @param mapName Map's name
+     *
+     * The json file is read if the binary one is older or not valid. Without a valid file,
+     * the map is left invalid.
      */
     void loadFromData(const std::string& mapName);
+    /**
+     * @brief Check if the binary file of a map in the data folder can be played
+     * @param mapName Map's name
+     * @return True if the binary file exists and is not older than the json one
+     *
+     * A binary file older than the json one is stale: the json one has been edited since.
+     */
+    [[nodiscard]] static bool isBinaryCurrent(const std::string& mapName);
     /**
      * @brief save a map
      * @param mapName Map's name
+     * @param format The file format
      */
-    void saveToData(const std::string& mapName);
+    void saveToData(const std::string& mapName, FileFormat format = FileFormat::Json);
     /**
-     * @brief load a map
+     * @brief load a map, the format being detected from the content
      * @param mapName Map's name
      */
     void loadFromFile(const std::string& mapName);
     /**
      * @brief save a map
      * @param mapName Map's name
+     * @param format The file format
+     */
+    void saveToFile(const std::string& mapName, FileFormat format = FileFormat::Json);
+
+    /**
+     * @brief Header of the binary format
+     */
+    struct BinaryHeader {
+        CellSizeType cubeSize = 64;       ///< Size of a cube
+        size_t lineCount      = 0;        ///< Amount of lines
+        size_t lineLength     = 0;        ///< Cells per line
+        worldCoordinates playerStart{};   ///< Player starting point
+        worldCoordinates playerStartDir{};///< Player starting direction
+    };
+    /**
+     * @brief Read and check the header of the binary format
+     * @param data The bytes of the whole file
+     * @param header The header read
+     * @return False if the data are not a valid binary map (null cube size, or not all the cells following the header)
+     */
+    static bool readBinaryHeader(std::span<const uint8_t> data, BinaryHeader& header);
+    /**
+     * @brief Read the map from the binary format
+     * @param data The bytes
+     * @return False if the data are not a valid map (the map is then left invalid)
+     *
+     * Little endian, header of binaryHeaderSize bytes: magic "RCMP", version (uint16),
+     * cube size (uint16), line count and line length (uint32 each), player start position
+     * and direction (4 doubles). Then one mapCell::toByte per cell, line after line.
+     */
+    bool fromBinary(std::span<const uint8_t> data);
+    /**
+     * @brief Write the map in the binary format
+     * @return The bytes
      */
-    void saveToFile(const std::string& mapName);
+    [[nodiscard]] std::vector<uint8_t> toBinary() const;
 
 private:
     /**
@@ -336,21 +729,58 @@ private:
      * @param width width
      * @param height height
      */
-    void reset(uint8_t width, uint8_t height);
+    void reset(IndexType width, IndexType height);
     /**
-     * @brief Update the size
+     * @brief Update the distance field and the occupancy bitmaps to the size
      */
     void updateSize();
+    /**
+     * @brief Compute the distance field in an area, from the distances around it
+     * @param firstX First column
+     * @param firstY First line
+     * @param lastX Last column
+     * @param lastY Last line
+     */
+    void computeDistances(size_t firstX, size_t firstY, size_t lastX, size_t lastY);
+    /**
+     * @brief Mark a cell in both levels of the occupancy
+     * @param location Cell's coordinates
+     * @param opaque If the cell stops the rays
+     */
+    void setOpaque(const gridCoordinate& location, bool opaque);
     /// Size of a cube
-    uint8_t cubeSize = 64;
+    CellSizeType cubeSize = 64;
     /// Player stating point in the map
     worldCoordinates PlayerInitialPosition{};
     /// Player Starting direction in the map
     worldCoordinates PlayerInitialDirection{};
+    /**
+     * @brief Unpack the lines into the cell planes
+     * @param data The lines
+     *
+     * If the lines have different sizes or are too large, the storage is left empty, and the map is invalid.
+     */
+    void fromLines(const DataType& data);
+    /**
+     * @brief Index of a cell in the storage
+     * @param location Cell's coordinates
+     * @return Index in the storage
+     */
+    [[nodiscard]] size_t index(const gridCoordinate& location) const { return location[1] * lineLength + location[0]; }
     /// The map data
-    DataType mapArray;
-    double maxWidth  = 0;
-    double maxHeight = 0;
+    StorageType mapArray;
+    /// Distance of each cell to the nearest wall, in cells (0 for walls)
+    std::vector<uint8_t> distanceField;
+    /// Cells stopping the rays, one bit per cell, line after line
+    std::vector<uint64_t> opaqueCells;
+    /// Blocks with a cell stopping the rays or past the border, one bit per block
+    std::vector<uint64_t> opaqueBlocks;
+    /// Amount of blocks per line of blocks
+    size_t blockColumns = 0;
+    /// Amount of lines in the map
+    size_t lineCount = 0;
+    /// Amount of cell in each line
+    size_t lineLength = 0;
 
     void fromJson(const nlohmann::json& data);
     nlohmann::json toJson() const;
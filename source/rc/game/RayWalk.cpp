@@ -0,0 +1,63 @@
+/**
+ * @file RayWalk.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "RayWalk.h"
+
+namespace rc::game::walk {
+
+RayWalk leap(RayWalk walk, int64_t crossingsX, int64_t crossingsY, int64_t columns) {
+    // the crossings of each axis do not depend on the other axis: no need to interleave them
+    double lastX   = walk.hitT;
+    double lastY   = walk.hitT;
+    double nextX   = walk.tMaxX;
+    double nextY   = walk.tMaxY;
+    int64_t countX = crossingsX;
+    int64_t countY = crossingsY;
+    // both chains of additions in the same loop: they run side by side
+    int64_t count = 0;
+    for (; count < crossingsX && count < crossingsY; ++count) {
+        lastX = nextX;
+        nextX += walk.tDeltaX;
+        lastY = nextY;
+        nextY += walk.tDeltaY;
+    }
+    for (int64_t countLeft = count; countLeft < crossingsX; ++countLeft) {
+        lastX = nextX;
+        nextX += walk.tDeltaX;
+    }
+    for (int64_t countLeft = count; countLeft < crossingsY; ++countLeft) {
+        lastY = nextY;
+        nextY += walk.tDeltaY;
+    }
+    // the ray leaves the area by the first of the two lines, on equal parameters the vertical one
+    if (nextX <= nextY) {
+        countY = 0;
+        for (nextY = walk.tMaxY; nextY < nextX; nextY += walk.tDeltaY) {
+            lastY = nextY;
+            ++countY;
+        }
+    } else {
+        countX = 0;
+        for (nextX = walk.tMaxX; nextX <= nextY; nextX += walk.tDeltaX) {
+            lastX = nextX;
+            ++countX;
+        }
+    }
+    if (countX == 0 && countY == 0)
+        return walk;
+    walk.vertical = countY == 0 || (countX > 0 && lastX > lastY);
+    walk.hitT     = walk.vertical ? lastX : lastY;
+    walk.tMaxX    = nextX;
+    walk.tMaxY    = nextY;
+    walk.cellX += walk.stepX * countX;
+    walk.cellY += walk.stepY * countY;
+    walk.idx += walk.stepX * countX + walk.stepY * countY * columns;
+    return walk;
+}
+
+}// namespace rc::game::walk
@@ -0,0 +1,180 @@
+/**
+ * @file RayWalk.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Map.h"
+#include "math/functions.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Grid traversal shared by the map and the chunked world: both return the same hits
+ */
+namespace rc::game::walk {
+
+/// Directions components under this are considered null (as in the two pass version)
+constexpr double minComponent = 0.001;
+/// The hit point is pushed by this amount inside the hit cell
+constexpr double nudge = 0.001;
+/// The ray leaps from the cells farther than this from the nearest wall, else it steps
+constexpr uint8_t minLeap = 2;
+
+/**
+ * @brief Grid traversal state of one ray
+ */
+struct RayWalk {
+    /// Ray parameter at the next vertical grid line crossing
+    double tMaxX;
+    /// Ray parameter at the next horizontal grid line crossing
+    double tMaxY;
+    /// Ray parameter between two vertical grid lines
+    double tDeltaX;
+    /// Ray parameter between two horizontal grid lines
+    double tDeltaY;
+    /// Ray parameter of the last crossing
+    double hitT;
+    /// Current cell column
+    int64_t cellX;
+    /// Current cell line
+    int64_t cellY;
+    /// Column step (+1 or -1)
+    int64_t stepX;
+    /// Line step (+1 or -1)
+    int64_t stepY;
+    /// Current cell index in the storage
+    int64_t idx;
+    /// If last crossing was a vertical grid line
+    bool vertical;
+};
+
+/**
+ * @brief Initialize the traversal of a ray
+ * @param from Starting point
+ * @param direction Ray's direction
+ * @param cube Cell size
+ * @param columns Cells per line
+ * @param walk The traversal state to initialize
+ * @return False if the direction is null
+ */
+inline bool startWalk(const Map::worldCoordinates& from, const Map::worldCoordinates& direction, double cube, int64_t columns, RayWalk& walk) {
+    constexpr double noCross = std::numeric_limits<double>::infinity();
+    const bool crossX        = std::abs(direction[0]) > minComponent;
+    const bool crossY        = std::abs(direction[1]) > minComponent;
+    if (!crossX && !crossY)
+        return false;
+    walk.stepX    = direction[0] > 0 ? 1 : -1;
+    walk.stepY    = direction[1] > 0 ? 1 : -1;
+    walk.cellX    = static_cast<int64_t>(from[0] / cube);
+    walk.cellY    = static_cast<int64_t>(from[1] / cube);
+    walk.tMaxX    = crossX ? std::abs((static_cast<double>(walk.cellX + math::heaviside(walk.stepX)) * cube - from[0]) / direction[0]) : noCross;
+    walk.tMaxY    = crossY ? std::abs((static_cast<double>(walk.cellY + math::heaviside(walk.stepY)) * cube - from[1]) / direction[1]) : noCross;
+    walk.tDeltaX  = crossX ? cube / std::abs(direction[0]) : noCross;
+    walk.tDeltaY  = crossY ? cube / std::abs(direction[1]) : noCross;
+    walk.idx      = walk.cellY * columns + walk.cellX;
+    walk.hitT     = 0;
+    walk.vertical = false;
+    return true;
+}
+
+/**
+ * @brief Step the ray from cell to cell until it stops
+ * @tparam Stop Callable as stop(walk), true if the ray stops in the current cell
+ * @param walk The traversal state
+ * @param columns Cells per line
+ * @param stop The stop condition
+ */
+template<class Stop>
+void walkUntil(RayWalk& walk, int64_t columns, Stop&& stop) {
+    const int64_t stride = walk.stepY * columns;
+    do {
+        walk.vertical = walk.tMaxX <= walk.tMaxY;
+        if (walk.vertical) {
+            walk.hitT = walk.tMaxX;
+            walk.tMaxX += walk.tDeltaX;
+            walk.cellX += walk.stepX;
+            walk.idx += walk.stepX;
+        } else {
+            walk.hitT = walk.tMaxY;
+            walk.tMaxY += walk.tDeltaY;
+            walk.cellY += walk.stepY;
+            walk.idx += stride;
+        }
+    } while (!stop(walk));
+}
+
+/**
+ * @brief Move the ray through all the cells it crosses inside an area ahead of the current cell
+ * @param walk The traversal state
+ * @param crossingsX Amount of vertical grid lines the ray may cross inside the area
+ * @param crossingsY Amount of horizontal grid lines the ray may cross inside the area
+ * @param columns Cells per line
+ * @return The state the stepping would give in the last cell before leaving the area
+ *
+ * All the cells of the area must be see-through and in the map. The parameters are
+ * accumulated as the stepping does: the state is exactly the same. Out of line, and the
+ * state passed by value: the stepping loops of the callers stay small, in registers.
+ */
+RayWalk leap(RayWalk walk, int64_t crossingsX, int64_t crossingsY, int64_t columns);
+
+/**
+ * @brief Walk the ray to the first cell stopping it, leaping over the empty space
+ * @tparam Cells The grid's cells, callable on the current cell of a walk: isOutside(walk),
+ * distance(walk) in the distance field (0 for the walls) and isInEmptyBlock(walk) for the occupancy
+ * @param walk The traversal state
+ * @param columns Cells per line
+ * @param cells The grid's cells
+ *
+ * The ray steps through the cells close to the walls. From the others, it leaps over the
+ * square without walls of the distance field, or to the end of its occupancy block if empty
+ * and farther. The ray stops on a wall or outside the grid.
+ */
+template<class Cells>
+void walkToWall(RayWalk& walk, int64_t columns, Cells& cells) {
+    constexpr auto blockMask = static_cast<int64_t>(Map::blockSize - 1);
+    const auto inBlock       = [](int64_t cell, int64_t step) { return step > 0 ? blockMask - (cell & blockMask) : cell & blockMask; };
+    const auto stop          = [&cells](const RayWalk& current) {
+        if (cells.isOutside(current))
+            return true;
+        const uint8_t distance = cells.distance(current);
+        return distance == 0 || distance > minLeap;
+    };
+    for (;;) {
+        walkUntil(walk, columns, stop);
+        if (cells.isOutside(walk))
+            return;
+        const int64_t radius = cells.distance(walk) - 1;
+        const int64_t blockX = inBlock(walk.cellX, walk.stepX);
+        const int64_t blockY = inBlock(walk.cellY, walk.stepY);
+        if (radius >= 0 && std::min(blockX, blockY) > radius && cells.isInEmptyBlock(walk))
+            walk = leap(walk, blockX, blockY, columns);
+        else if (radius >= minLeap)
+            walk = leap(walk, radius, radius, columns);
+        else
+            return;
+    }
+}
+
+/**
+ * @brief Build the hit data of a finished traversal
+ * @param walk The traversal state
+ * @param from Starting point
+ * @param direction Ray's direction
+ * @param cube Cell size
+ * @return Hit data
+ */
+inline Map::rayCastResult hitResult(const RayWalk& walk, const Map::worldCoordinates& from, const Map::worldCoordinates& direction, double cube) {
+    Map::worldCoordinates wallPoint = from + direction * walk.hitT;
+    if (walk.vertical) {
+        wallPoint[0] += static_cast<double>(walk.stepX) * nudge;
+        return {(wallPoint - from).length(), wallPoint, true, std::abs(wallPoint[1] - (static_cast<double>(walk.cellY) + math::heaviside(-direction[0])) * cube)};
+    }
+    wallPoint[1] += static_cast<double>(walk.stepY) * nudge;
+    return {(wallPoint - from).length(), wallPoint, false, std::abs(wallPoint[0] - (static_cast<double>(walk.cellX) + math::heaviside(direction[1])) * cube)};
+}
+
+}// namespace rc::game::walk
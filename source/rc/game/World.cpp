@@ -0,0 +1,216 @@
+/**
+ * @file World.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "World.h"
+#include "Grid.h"
+#include "RayWalk.h"
+#include "core/fs/DataFile.h"
+#include <algorithm>
+
+namespace rc::game {
+
+/// Cell coordinate mask inside a chunk
+static constexpr size_t chunkMask = World::chunkSize - 1;
+
+/**
+ * @brief Index of the occupancy block of a cell in its chunk
+ * @param posX Cell column in the chunk
+ * @param posY Cell line in the chunk
+ * @return The block's index
+ */
+static constexpr size_t blockOf(size_t posX, size_t posY) {
+    return (posY >> Map::blockBits) * World::chunkBlocks + (posX >> Map::blockBits);
+}
+
+bool World::open(const std::filesystem::path& file) {
+    close();
+    m_file = core::fs::MappedFile(file);
+    if (!Map::readBinaryHeader(m_file.data(), m_header)) {
+        close();
+        return false;
+    }
+    m_chunkColumns = (m_header.lineLength + chunkMask) >> chunkBits;
+    m_chunkLines   = (m_header.lineCount + chunkMask) >> chunkBits;
+    m_table.assign(m_chunkColumns * m_chunkLines, noSlot);
+    return true;
+}
+
+bool World::openData(const std::string& mapName) {
+    // same rule as Map::loadFromData: a stale binary file is not played
+    if (!Map::isBinaryCurrent(mapName)) {
+        close();
+        return false;
+    }
+    const core::fs::DataFile file(std::filesystem::path("maps") / (mapName + ".rcmap"));
+    return open(file.getFullPath());
+}
+
+void World::close() {
+    m_file   = core::fs::MappedFile();
+    m_header = {};
+    m_table.clear();
+    m_chunks.clear();
+    m_slots.clear();
+    m_chunkColumns = 0;
+    m_chunkLines   = 0;
+    m_frame        = 0;
+    m_pageIns      = 0;
+}
+
+void World::setMemoryBudget(size_t bytes) {
+    m_budget = bytes;
+    // the chunks are paged in again, as needed
+    std::fill(m_table.begin(), m_table.end(), noSlot);
+    m_chunks.clear();
+    m_slots.clear();
+}
+
+void World::update(const worldCoordinates& position, size_t radius) {
+    ++m_frame;
+    if (!isValid())
+        return;
+    const gridCoordinate cell = whichCell(position);
+    const size_t centerX      = std::min<size_t>(cell[0], width() - 1) >> chunkBits;
+    const size_t centerY      = std::min<size_t>(cell[1], height() - 1) >> chunkBits;
+    for (size_t chunkY = centerY - std::min(centerY, radius); chunkY <= std::min(centerY + radius, m_chunkLines - 1); ++chunkY)
+        for (size_t chunkX = centerX - std::min(centerX, radius); chunkX <= std::min(centerX + radius, m_chunkColumns - 1); ++chunkX)
+            static_cast<void>(getChunk(chunkX, chunkY));
+}
+
+const World::Chunk& World::getChunk(size_t chunkX, size_t chunkY) const {
+    const size_t chunkIndex = chunkY * m_chunkColumns + chunkX;
+    uint32_t slot           = m_table[chunkIndex];
+    if (slot == noSlot)
+        slot = pageIn(chunkIndex);
+    m_slots[slot].lastUse = m_frame;
+    return m_chunks[slot];
+}
+
+uint32_t World::pageIn(size_t chunkIndex) const {
+    uint32_t slot;
+    if (m_chunks.size() < std::max<size_t>(m_budget / sizeof(Chunk), 1)) {
+        slot = static_cast<uint32_t>(m_chunks.size());
+        m_chunks.emplace_back();
+        m_slots.push_back({chunkIndex, 0});
+    } else {
+        // pages in are rare: a scan of the resident chunks is fine
+        const auto oldest = std::min_element(m_slots.begin(), m_slots.end(), [](const Slot& left, const Slot& right) { return left.lastUse < right.lastUse; });
+        slot              = static_cast<uint32_t>(oldest - m_slots.begin());
+        m_table[oldest->chunkIndex] = noSlot;
+        oldest->chunkIndex          = chunkIndex;
+    }
+    m_table[chunkIndex] = slot;
+    ++m_pageIns;
+    // decode the chunk's lines, cells past the map's border are walls
+    auto& chunk         = m_chunks[slot];
+    const size_t firstX = (chunkIndex % m_chunkColumns) << chunkBits;
+    const size_t firstY = (chunkIndex / m_chunkColumns) << chunkBits;
+    const size_t countX = std::min(chunkSize, width() - firstX);
+    const size_t countY = std::min(chunkSize, height() - firstY);
+    const auto cells    = m_file.data().subspan(Map::binaryHeaderSize);
+    chunk.cells.fill(mapCell{false, false, 2});
+    for (size_t line = 0; line < countY; ++line) {
+        const auto bytes = cells.subspan((firstY + line) * width() + firstX, countX);
+        std::transform(bytes.begin(), bytes.end(), chunk.cells.begin() + static_cast<std::ptrdiff_t>(line << chunkBits), mapCell::fromByte);
+    }
+    // distances as in the map: computed with the cells around the chunk, up to the largest distance
+    constexpr size_t margin = Map::maxDistance;
+    const size_t windowX    = firstX - std::min(firstX, margin);
+    const size_t windowY    = firstY - std::min(firstY, margin);
+    const size_t columns    = std::min(firstX + chunkSize + margin, width()) - windowX;
+    const size_t lines      = std::min(firstY + chunkSize + margin, height()) - windowY;
+    std::vector<uint8_t> window(columns * lines);
+    grid::computeDistances(window, columns, lines, 0, 0, columns - 1, lines - 1, [&](size_t cell) {
+        return mapCell::fromByte(cells[(windowY + cell / columns) * width() + windowX + cell % columns]).visibility;
+    });
+    chunk.distances.fill(0);
+    for (size_t line = 0; line < countY; ++line)
+        std::copy_n(window.begin() + static_cast<std::ptrdiff_t>((firstY - windowY + line) * columns + firstX - windowX), countX, chunk.distances.begin() + static_cast<std::ptrdiff_t>(line << chunkBits));
+    chunk.nonEmpty = 0;
+    for (size_t cell = 0; cell < chunk.cells.size(); ++cell)
+        if (!chunk.cells[cell].visibility)
+            chunk.nonEmpty |= static_cast<uint16_t>(1U << blockOf(cell & chunkMask, cell >> chunkBits));
+    return slot;
+}
+
+std::vector<uint8_t> World::getTextureIds() const {
+    std::array<bool, std::numeric_limits<uint8_t>::max() + 1> usedBytes{};
+    for (const uint8_t byte : m_file.data().subspan(std::min(Map::binaryHeaderSize, m_file.data().size())))
+        usedBytes[byte] = true;
+    std::array<bool, std::numeric_limits<uint8_t>::max() + 1> used{};
+    for (size_t byte = 0; byte < usedBytes.size(); ++byte) {
+        const auto cell = mapCell::fromByte(static_cast<uint8_t>(byte));
+        // same IDs as Map::getTextureIds: the walls' known textures
+        if (usedBytes[byte] && !cell.visibility && cell.hasTexture())
+            used[cell.textureId] = true;
+    }
+    std::vector<uint8_t> ids;
+    for (size_t id = 0; id < used.size(); ++id)
+        if (used[id])
+            ids.push_back(static_cast<uint8_t>(id));
+    return ids;
+}
+
+const mapCell& World::at(const gridCoordinate& location) const {
+    const auto& chunk = getChunk(location[0] >> chunkBits, location[1] >> chunkBits);
+    return chunk.cells[((location[1] & chunkMask) << chunkBits) | (location[0] & chunkMask)];
+}
+
+World::gridCoordinate World::whichCell(const worldCoordinates& from) const {
+    return grid::whichCell(from, m_header.cubeSize);
+}
+
+bool World::isIn(const worldCoordinates& from) const {
+    return grid::isIn(from, width(), height(), m_header.cubeSize);
+}
+
+World::worldCoordinates World::possibleMove(const worldCoordinates& Start, const worldCoordinates& Expected) const {
+    return grid::possibleMove(Start, Expected, [this](const worldCoordinates& point) { return isInPassable(point); });
+}
+
+World::rayCastResult World::castRay(const worldCoordinates& from, const worldCoordinates& direction) const {
+    const auto columns = static_cast<int64_t>(width());
+    walk::RayWalk walk{};
+    if (!isValid() || !walk::startWalk(from, direction, m_header.cubeSize, columns, walk))
+        return {0, from, false, 0};
+    /**
+     * @brief The chunks, as seen by the ray walk
+     */
+    struct ChunkCells {
+        const World& world;          ///< The world
+        int64_t columns;             ///< Cells per line
+        int64_t lines;               ///< Amount of lines
+        const Chunk* chunk = nullptr;///< Chunk of the last cell looked at
+        int64_t chunkX     = -1;     ///< Column of the chunk
+        int64_t chunkY     = -1;     ///< Line of the chunk
+
+        [[nodiscard]] bool isOutside(const walk::RayWalk& current) const {
+            return current.cellX < 0 || current.cellY < 0 || current.cellX >= columns || current.cellY >= lines;
+        }
+        const Chunk& chunkOf(const walk::RayWalk& current) {
+            if ((current.cellX >> chunkBits) != chunkX || (current.cellY >> chunkBits) != chunkY) {
+                chunkX = current.cellX >> chunkBits;
+                chunkY = current.cellY >> chunkBits;
+                chunk  = &world.getChunk(static_cast<size_t>(chunkX), static_cast<size_t>(chunkY));
+            }
+            return *chunk;
+        }
+        static size_t cellOf(const walk::RayWalk& current) {
+            return ((static_cast<size_t>(current.cellY) & chunkMask) << chunkBits) | (static_cast<size_t>(current.cellX) & chunkMask);
+        }
+        uint8_t distance(const walk::RayWalk& current) { return chunkOf(current).distances[cellOf(current)]; }
+        bool isInEmptyBlock(const walk::RayWalk& current) {
+            return ((chunkOf(current).nonEmpty >> blockOf(static_cast<size_t>(current.cellX) & chunkMask, static_cast<size_t>(current.cellY) & chunkMask)) & 1U) == 0;
+        }
+    };
+    ChunkCells cells{*this, columns, static_cast<int64_t>(height())};
+    walk::walkToWall(walk, columns, cells);
+    return walk::hitResult(walk, from, direction, m_header.cubeSize);
+}
+
+}// namespace rc::game
@@ -0,0 +1,268 @@
+/**
+ * @file World.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Grid.h"
+#include "Map.h"
+#include "core/fs/MappedFile.h"
+#include <array>
+#include <deque>
+
+namespace rc::game {
+
+/**
+ * @brief Class World
+ *
+ * A level read from a binary map file by chunks of chunkSize x chunkSize cells, for
+ * levels too large to be decoded at once. A chunk table gives the resident chunk of each
+ * part of the grid: the missing ones are decoded from the mapped file when first touched,
+ * and the least recently used ones are dropped to stay under the memory budget.
+ *
+ * Queries answer as the Map of the same file would, with the same grid queries and ray walk.
+ * They are const but may page chunks in: a World is not thread-safe, and a cell reference is
+ * only valid until the next query.
+ * Unlike Map, width() is the amount of cells per line (x) and height() the amount of lines (y).
+ */
+class World {
+public:
+    /// Grid coordinate's type
+    using gridCoordinate = Map::gridCoordinate;
+    /// World coordinate's type
+    using worldCoordinates = Map::worldCoordinates;
+    /// Ray casting result's type
+    using rayCastResult = Map::rayCastResult;
+    /// Bits of a cell coordinate inside its chunk
+    static constexpr size_t chunkBits = 5;
+    /// Chunk side in cells
+    static constexpr size_t chunkSize = size_t{1} << chunkBits;
+    /// Occupancy blocks per line of a chunk
+    static constexpr size_t chunkBlocks = chunkSize / Map::blockSize;
+    static_assert(chunkBlocks * chunkBlocks <= 16, "the occupancy of a chunk must fit in 16 bits");
+    /**
+     * @brief Cells of a chunk, with what the ray walk needs to leap over their empty space
+     */
+    struct Chunk {
+        std::array<mapCell, chunkSize * chunkSize> cells;    ///< The cells, line after line
+        std::array<uint8_t, chunkSize * chunkSize> distances;///< Distance field of the cells, as in the map
+        uint16_t nonEmpty;                                   ///< Occupancy blocks with a cell stopping the rays, one bit per block
+    };
+
+    World(const World&)            = delete;
+    World& operator=(const World&) = delete;
+    /**
+     * @brief Default move constructor
+     */
+    World(World&&) = default;
+    /**
+     * @brief Default move assignation
+     * @return this
+     */
+    World& operator=(World&&) = default;
+    /**
+     * @brief Default constructor.
+     */
+    World() = default;
+    /**
+     * @brief Destructor.
+     */
+    ~World() = default;
+
+    /**
+     * @brief Open a binary map file
+     * @param file The file's full path
+     * @return False if not a valid binary map
+     */
+    bool open(const std::filesystem::path& file);
+    /**
+     * @brief Open a binary map of the data folder
+     * @param mapName Map's name
+     * @return False if not a valid binary map, or if it is older than the json one (see Map::isBinaryCurrent)
+     */
+    bool openData(const std::string& mapName);
+    /**
+     * @brief Close the file and drop all the chunks
+     */
+    void close();
+    /**
+     * @brief Check if a map is open
+     * @return True if open
+     */
+    [[nodiscard]] bool isValid() const { return m_file.isOpen() && m_header.lineCount > 0; }
+
+    /**
+     * @brief Get the amount of cells per line
+     * @return The width
+     */
+    [[nodiscard]] size_t width() const { return m_header.lineLength; }
+    /**
+     * @brief Get the amount of lines
+     * @return The height
+     */
+    [[nodiscard]] size_t height() const { return m_header.lineCount; }
+    /**
+     * @brief Get the cube's size
+     * @return Cube's size
+     */
+    [[nodiscard]] Map::CellSizeType getCellSize() const { return m_header.cubeSize; }
+    /**
+     * @brief Get player start information
+     * @return Player start state
+     */
+    [[nodiscard]] std::tuple<const worldCoordinates&, const worldCoordinates&> getPlayerStart() const { return {m_header.playerStart, m_header.playerStartDir}; }
+    /**
+     * @brief Get the texture IDs used by the walls, read from the file without paging chunks in
+     * @return The IDs that have a texture, in increasing order
+     */
+    [[nodiscard]] std::vector<uint8_t> getTextureIds() const;
+
+    /**
+     * @brief Define the memory the resident chunks may use
+     * @param bytes The budget (at least one chunk is kept)
+     */
+    void setMemoryBudget(size_t bytes);
+    /**
+     * @brief Get the memory the resident chunks may use
+     * @return The budget in bytes
+     */
+    [[nodiscard]] size_t getMemoryBudget() const { return m_budget; }
+    /**
+     * @brief Get the memory used by the resident chunks
+     * @return Size in bytes
+     */
+    [[nodiscard]] size_t getMemoryUsage() const { return m_chunks.size() * sizeof(Chunk); }
+    /**
+     * @brief Get the amount of resident chunks
+     * @return Amount of chunks
+     */
+    [[nodiscard]] size_t getResidentChunks() const { return m_chunks.size(); }
+    /**
+     * @brief Get the amount of chunks decoded since the map was opened
+     * @return Amount of chunks
+     */
+    [[nodiscard]] size_t getPageIns() const { return m_pageIns; }
+
+    /**
+     * @brief Start a new frame: page in the chunks around a point, now the most recently used ones
+     * @param position The point (usually the player)
+     * @param radius Amount of chunks loaded on each side of the point's chunk
+     */
+    void update(const worldCoordinates& position, size_t radius = 1);
+
+    /**
+     * @brief Access to a cell
+     * @param location Coordinates, in the map
+     * @return The cell
+     */
+    [[nodiscard]] const mapCell& at(const gridCoordinate& location) const;
+    /**
+     * @brief Determine the cell where the point lies.
+     * @param from The point to check
+     * @return The cell, coordinates outside the map give the max index
+     */
+    [[nodiscard]] gridCoordinate whichCell(const worldCoordinates& from) const;
+    /**
+     * @brief Check if a point is in the map
+     * @param from The point to check
+     * @return True if in the map
+     */
+    [[nodiscard]] bool isIn(const worldCoordinates& from) const;
+    /**
+     * @brief Checks if grid coordinates are in the map
+     * @param from Grid coordinates to check
+     * @return True if in the map
+     */
+    [[nodiscard]] bool isIn(const gridCoordinate& from) const { return grid::isIn(from, width(), height()); }
+    /**
+     * @brief Check if a point is in the map and player can pass through
+     * @param from The point to check
+     * @return True if in the map
+     */
+    [[nodiscard]] bool isInPassable(const worldCoordinates& from) const { return isIn(from) && isInPassable(whichCell(from)); }
+    /**
+     * @brief Checks if grid coordinates are in the map and player can pass through
+     * @param from Grid coordinates to check
+     * @return True if in the map
+     */
+    [[nodiscard]] bool isInPassable(const gridCoordinate& from) const { return isIn(from) && at(from).passable; }
+    /**
+     * @brief Check if a point is in the map and player can see through
+     * @param from The point to check
+     * @return True if in the map
+     */
+    [[nodiscard]] bool isInVisible(const worldCoordinates& from) const { return isIn(from) && isInVisible(whichCell(from)); }
+    /**
+     * @brief Checks if grid coordinates are in the map and player can see through
+     * @param from Grid coordinates to check
+     * @return True if in the map
+     */
+    [[nodiscard]] bool isInVisible(const gridCoordinate& from) const { return isIn(from) && at(from).visibility; }
+    /**
+     * @brief Check and modify the expected move according to map constrains
+     * @param Start Actual Position
+     * @param Expected Expected move
+     * @return Effective move
+     */
+    [[nodiscard]] worldCoordinates possibleMove(const worldCoordinates& Start, const worldCoordinates& Expected) const;
+    /**
+     * @brief Cast a ray in the 2D space, as Map::castRay
+     * @param from Starting point
+     * @param direction Ray's direction
+     * @return Hit data
+     *
+     * The ray leaps over the empty space with the distance field and the occupancy of the chunks.
+     * The chunk is looked up in the table only when the ray enters a new chunk.
+     */
+    [[nodiscard]] rayCastResult castRay(const worldCoordinates& from, const worldCoordinates& direction) const;
+
+private:
+    /// Slot of the chunks not resident
+    static constexpr uint32_t noSlot = ~0U;
+    /**
+     * @brief Resident chunk
+     */
+    struct Slot {
+        size_t chunkIndex = 0;///< Chunk in the table
+        uint64_t lastUse  = 0;///< Frame of the last use
+    };
+    /**
+     * @brief Get a chunk, paged in if needed
+     * @param chunkX Chunk column
+     * @param chunkY Chunk line
+     * @return The chunk
+     */
+    [[nodiscard]] const Chunk& getChunk(size_t chunkX, size_t chunkY) const;
+    /**
+     * @brief Decode a chunk from the file, in a free slot or in the least recently used one
+     * @param chunkIndex Chunk in the table
+     * @return The chunk's slot
+     */
+    uint32_t pageIn(size_t chunkIndex) const;
+
+    /// The map file
+    core::fs::MappedFile m_file;
+    /// The map's header
+    Map::BinaryHeader m_header;
+    /// Amount of chunks per line of chunks
+    size_t m_chunkColumns = 0;
+    /// Amount of lines of chunks
+    size_t m_chunkLines = 0;
+    /// Memory the resident chunks may use
+    size_t m_budget = size_t{16} << 20U;
+    /// Slot of each chunk of the map
+    mutable std::vector<uint32_t> m_table;
+    /// Resident chunks (a deque: a chunk does not move when others are added)
+    mutable std::deque<Chunk> m_chunks;
+    /// Use of the resident chunks, by slot
+    mutable std::vector<Slot> m_slots;
+    /// Current frame
+    uint64_t m_frame = 0;
+    /// Amount of chunks decoded
+    mutable size_t m_pageIns = 0;
+};
+
+}// namespace rc::game
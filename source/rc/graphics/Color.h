@@ -8,6 +8,7 @@
 
 #pragma once
 #include "math/functions.h"
+#include <bit>
 #include <nlohmann/json.hpp>
 
 /**
@@ -142,34 +143,34 @@ public:
      * @param other Other color to compare
      * @return True if equal
      */
-    [[nodiscard]] bool operator==(const Color& other)const { return code() == other.code(); }
+    [[nodiscard]] bool operator==(const Color& other)const { return std::bit_cast<uint32_t>(*this) == std::bit_cast<uint32_t>(other); }
 
     /**
      * @brief Comparison operator
      * @param other Other color to compare
      * @return True if not equal
      */
-    [[nodiscard]] bool operator!=(const Color& other)const { return code() != other.code(); }
+    [[nodiscard]] bool operator!=(const Color& other)const { return !(*this == other); }
 
     /**
-     * @brief Make this color a bit darker
+     * @brief Make this color a bit darker: 90% of each channel, rounded down
      * @return This
      */
     Color& darken(){
-        R=static_cast<uint8_t>(0.9 * R);
-        G=static_cast<uint8_t>(0.9 * G);
-        B=static_cast<uint8_t>(0.9 * B);
+        R=static_cast<uint8_t>(R * 9 / 10);
+        G=static_cast<uint8_t>(G * 9 / 10);
+        B=static_cast<uint8_t>(B * 9 / 10);
         return *this;
     }
 
     /**
-     * @brief Make this color a bit lighter
+     * @brief Make this color a bit lighter: 110% of each channel, rounded down and saturated
      * @return This
      */
     Color& lighten(){
-        R=static_cast<uint8_t>(1.1 * R);
-        G=static_cast<uint8_t>(1.1 * G);
-        B=static_cast<uint8_t>(1.1 * B);
+        R=static_cast<uint8_t>(std::min(R * 11 / 10, 255));
+        G=static_cast<uint8_t>(std::min(G * 11 / 10, 255));
+        B=static_cast<uint8_t>(std::min(B * 11 / 10, 255));
         return *this;
     }
 
@@ -0,0 +1,154 @@
+/**
+ * @file Pixels.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "Pixels.h"
+#include <algorithm>
+#include <cstring>
+
+namespace rc::graphics {
+
+namespace {
+
+/// Two 8 bits channels in 16 bits lanes of a packed color
+constexpr PackedColor laneMask = 0x00FF00FFU;
+/// Position of the red and blue lanes
+constexpr uint32_t redBlueShift = std::min(redShift, blueShift);
+/// Position of the green and alpha lanes
+constexpr uint32_t greenAlphaShift = std::min(greenShift, alphaShift);
+/// Green channel of a packed color
+constexpr PackedColor greenMask = 0xFFU << greenShift;
+/// Alpha channel of a packed color
+constexpr PackedColor alphaMask = 0xFFU << alphaShift;
+
+/**
+ * @brief Load a pixel as a packed color
+ *
+ * Through memcpy: the compiler vectorizes the kernels' loops, which it does not do with bit_cast.
+ * @param pixel The pixel
+ * @return The packed color
+ */
+inline PackedColor load(const Color& pixel) {
+    PackedColor packed;
+    std::memcpy(&packed, &pixel, sizeof(PackedColor));
+    return packed;
+}
+
+/**
+ * @brief Store a packed color in a pixel
+ * @param pixel The pixel
+ * @param packed The packed color
+ */
+inline void store(Color& pixel, PackedColor packed) {
+    std::memcpy(static_cast<void*>(&pixel), &packed, sizeof(PackedColor));
+}
+
+/**
+ * @brief Darken two lanes: c * 9 / 10, computed as (c * 230 + (c * 106 >> 8)) >> 8 to stay in 16 bits
+ * @param lanes The lanes
+ * @return The darkened lanes
+ */
+constexpr PackedColor darkenLanes(PackedColor lanes) {
+    return ((lanes * 230U + ((lanes * 106U >> 8U) & laneMask)) >> 8U) & laneMask;
+}
+
+/**
+ * @brief Divide two lanes by 255 with rounding, exact for values up to 255 * 255
+ * @param lanes The lanes
+ * @return The quotients
+ */
+constexpr PackedColor divide255Lanes(PackedColor lanes) {
+    lanes += 0x00800080U;
+    return ((lanes + ((lanes >> 8U) & laneMask)) >> 8U) & laneMask;
+}
+
+/**
+ * @brief Darken a packed color, as Color::darken does
+ * @param packed The packed color
+ * @return The darkened color
+ */
+constexpr PackedColor darkenPacked(PackedColor packed) {
+    return darkenLanes(packed >> redBlueShift & laneMask) << redBlueShift |
+           (darkenLanes(packed >> greenAlphaShift & laneMask) << greenAlphaShift & greenMask) |
+           (packed & alphaMask);
+}
+
+/**
+ * @brief Blend a packed color over another
+ * @param source The color to draw
+ * @param dest The color to draw on
+ * @return The blended color
+ */
+constexpr PackedColor blendPacked(PackedColor source, PackedColor dest) {
+    const PackedColor opacity = source >> alphaShift & 0xFFU;
+    const PackedColor inverse = 255U - opacity;
+    const auto mix            = [=](uint32_t shift) { return divide255Lanes((source >> shift & laneMask) * opacity + (dest >> shift & laneMask) * inverse) << shift; };
+    return mix(redBlueShift) | (mix(greenAlphaShift) & greenMask) |
+           (opacity + (divide255Lanes((dest >> alphaShift & 0xFFU) * inverse))) << alphaShift;
+}
+
+}// namespace
+
+void fillPixels(std::span<Color> pixels, const Color& color) {
+    std::fill(pixels.begin(), pixels.end(), color);
+}
+
+void darkenPixels(std::span<Color> pixels) {
+    for (auto& pixel : pixels)
+        store(pixel, darkenPacked(load(pixel)));
+}
+
+void darkenPixels(std::span<const Color> source, std::span<Color> dest) {
+    const size_t count = std::min(source.size(), dest.size());
+    for (size_t i = 0; i < count; ++i)
+        store(dest[i], darkenPacked(load(source[i])));
+}
+
+void blendPixels(std::span<const Color> source, std::span<Color> dest) {
+    const size_t count = std::min(source.size(), dest.size());
+    for (size_t i = 0; i < count; ++i)
+        store(dest[i], blendPacked(load(source[i]), load(dest[i])));
+}
+
+void swapRedBlue(std::span<Color> pixels) {
+    constexpr PackedColor keep = ~(0xFFU << redShift | 0xFFU << blueShift);
+    for (auto& pixel : pixels) {
+        const PackedColor packed = load(pixel);
+        store(pixel, (packed & keep) | (packed >> redShift & 0xFFU) << blueShift | (packed >> blueShift & 0xFFU) << redShift);
+    }
+}
+
+void unpackPixels(std::span<const uint8_t> bytes, uint8_t channels, std::span<Color> pixels, size_t stride) {
+    if (channels == 0 || channels > 4 || stride == 0)
+        return;
+    const size_t count = std::min((pixels.size() + stride - 1) / stride, bytes.size() / channels);
+    const uint8_t* row = bytes.data();
+    switch (channels) {
+        case 1:// monochrome
+            for (size_t i = 0; i < count; ++i)
+                pixels[i * stride] = Color(row[i], row[i], row[i], 255);
+            break;
+        case 2:// monochrome + alpha
+            for (size_t i = 0; i < count; ++i)
+                pixels[i * stride] = Color(row[2 * i], row[2 * i], row[2 * i], row[2 * i + 1]);
+            break;
+        case 3:// RGB
+            for (size_t i = 0; i < count; ++i)
+                pixels[i * stride] = Color(row[3 * i], row[3 * i + 1], row[3 * i + 2], 255);
+            break;
+        default:// RGBA: same layout as the colors
+            if (stride == 1) {
+                std::memcpy(static_cast<void*>(pixels.data()), row, count * sizeof(Color));
+                break;
+            }
+            for (size_t i = 0; i < count; ++i)
+                std::memcpy(static_cast<void*>(&pixels[i * stride]), row + 4 * i, sizeof(Color));
+            break;
+    }
+}
+
+}// namespace rc::graphics
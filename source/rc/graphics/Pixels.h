@@ -0,0 +1,86 @@
+/**
+ * @file Pixels.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Color.h"
+#include <bit>
+#include <span>
+#include <type_traits>
+
+namespace rc::graphics {
+
+/**
+ * @brief Color packed in 32 bits, with the same memory layout as Color (R, G, B, A bytes)
+ *
+ * A pixel is copied, filled or compared as one integer. The bulk kernels below work on
+ * spans of pixels with integer arithmetic only, in loops the compiler vectorizes.
+ */
+using PackedColor = uint32_t;
+
+static_assert(sizeof(Color) == sizeof(PackedColor) && std::is_trivially_copyable_v<Color>, "Color must be packable in 32 bits");
+
+/// Bit position of the red channel in a packed color
+constexpr uint32_t redShift = std::endian::native == std::endian::little ? 0U : 24U;
+/// Bit position of the green channel in a packed color
+constexpr uint32_t greenShift = std::endian::native == std::endian::little ? 8U : 16U;
+/// Bit position of the blue channel in a packed color
+constexpr uint32_t blueShift = std::endian::native == std::endian::little ? 16U : 8U;
+/// Bit position of the alpha channel in a packed color
+constexpr uint32_t alphaShift = std::endian::native == std::endian::little ? 24U : 0U;
+
+/**
+ * @brief Pack a color
+ * @param color The color
+ * @return The packed color
+ */
+constexpr PackedColor pack(const Color& color) { return std::bit_cast<PackedColor>(color); }
+/**
+ * @brief Unpack a color
+ * @param packed The packed color
+ * @return The color
+ */
+constexpr Color unpack(PackedColor packed) { return std::bit_cast<Color>(packed); }
+
+/**
+ * @brief Fill pixels with a color
+ * @param pixels The pixels
+ * @param color The color
+ */
+void fillPixels(std::span<Color> pixels, const Color& color);
+/**
+ * @brief Darken pixels, as Color::darken does
+ * @param pixels The pixels
+ */
+void darkenPixels(std::span<Color> pixels);
+/**
+ * @brief Write darkened pixels, as Color::darker does
+ * @param source The pixels to darken
+ * @param dest The destination, at least as large as the source
+ */
+void darkenPixels(std::span<const Color> source, std::span<Color> dest);
+/**
+ * @brief Blend pixels over others with their alpha channel (source over destination)
+ * @param source The pixels to draw
+ * @param dest The pixels to draw on, at least as large as the source
+ */
+void blendPixels(std::span<const Color> source, std::span<Color> dest);
+/**
+ * @brief Swap the red and blue channels: RGBA to BGRA, and back
+ * @param pixels The pixels
+ */
+void swapRedBlue(std::span<Color> pixels);
+/**
+ * @brief Convert a row of 8 bits image bytes into pixels
+ * @param bytes The bytes: gray, gray + alpha, RGB or RGBA
+ * @param channels Amount of channels per pixel (1 to 4)
+ * @param pixels The destination pixels
+ * @param stride Distance between two destination pixels (the column's height to fill a column major image)
+ */
+void unpackPixels(std::span<const uint8_t> bytes, uint8_t channels, std::span<Color> pixels, size_t stride = 1);
+
+}// namespace rc::graphics
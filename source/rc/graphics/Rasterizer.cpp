@@ -0,0 +1,63 @@
+/**
+ * @file Rasterizer.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "Rasterizer.h"
+#include "Pixels.h"
+#include "WallSpan.h"
+#include <algorithm>
+#include <cmath>
+
+namespace rc::graphics {
+
+void drawWallColumn(image::Texture& target, size_t column, double lineY, double lineLength, const image::Texture& wall, double texX, double clipTop, double clipBottom, bool shade) {
+    if (wall.width() == 0 || wall.height() == 0)
+        return;
+    // distant walls read a smaller mipmap level, if any
+    const auto& tex = wall.getMipmapFor(lineLength);
+    texX *= static_cast<double>(tex.width()) / static_cast<double>(wall.width());
+    drawWallColumn(target, column, lineY, lineLength, tex.view(), texX, clipTop, clipBottom, shade);
+}
+
+void drawWallColumn(image::Texture& target, size_t column, double lineY, double lineLength, const image::TextureView& tex, double texX, double clipTop, double clipBottom, bool shade) {
+    if (tex.empty())
+        return;
+    const WallSpan span(lineY, lineLength, tex.height, clipTop, std::min(clipBottom, static_cast<double>(target.height())));
+    if (span.empty())
+        return;
+    // shaded texels are read from the shaded pixels, if any
+    const bool darken      = shade && tex.shaded == nullptr;
+    const auto texColumn   = static_cast<size_t>(std::min(texX, static_cast<double>(tex.width - 1)));
+    const Color* source    = (darken || !shade ? tex.pixels : tex.shaded) + texColumn * tex.rowStride;
+    const size_t texStride = tex.columnStride;
+    Color* dest            = target.data() + target.pixelIndex(column, span.firstRow());
+    const size_t stride    = target.columnStride();
+    span.forEach([=](size_t pixel, size_t textureRow) { dest[pixel * stride] = source[textureRow * texStride]; });
+    if (darken) {
+        if (stride == 1)
+            darkenPixels(std::span(dest, span.count()));
+        else
+            for (size_t pixel = 0; pixel < span.count(); ++pixel)
+                dest[pixel * stride].darken();
+    }
+}
+
+void fillColumn(image::Texture& target, size_t column, int32_t rowBegin, int32_t rowEnd, const Color& color) {
+    const auto height = static_cast<int32_t>(target.height());
+    rowBegin          = std::clamp(rowBegin, 0, height);
+    rowEnd            = std::clamp(rowEnd, rowBegin, height);
+    Color* dest       = target.data() + target.pixelIndex(column, static_cast<size_t>(rowBegin));
+    const auto stride = target.columnStride();
+    if (stride == 1) {
+        fillPixels(std::span(dest, static_cast<size_t>(rowEnd - rowBegin)), color);
+        return;
+    }
+    for (int32_t row = rowBegin; row < rowEnd; ++row, dest += stride)
+        *dest = color;
+}
+
+}// namespace rc::graphics
@@ -0,0 +1,52 @@
+/**
+ * @file Rasterizer.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "graphics/image/Texture.h"
+
+namespace rc::graphics {
+
+/**
+ * @brief Draw a textured wall column into a frame buffer
+ * @param target The frame buffer
+ * @param column Column of the frame buffer (must exist)
+ * @param lineY Row of the wall's top (may be outside the clipping range)
+ * @param lineLength Height of the wall
+ * @param tex Wall's texture, its mipmap level is chosen from the line length
+ * @param texX Column in the wall's texture (level 0)
+ * @param clipTop First row that may be drawn
+ * @param clipBottom End of the drawable rows (excluded)
+ * @param shade If the color should be shaded (read from the texture's shaded copy if any)
+ */
+void drawWallColumn(image::Texture& target, size_t column, double lineY, double lineLength, const image::Texture& tex, double texX, double clipTop, double clipBottom, bool shade);
+
+/**
+ * @brief Draw a textured wall column into a frame buffer, from pixels already at the right mipmap level
+ * @param target The frame buffer
+ * @param column Column of the frame buffer (must exist)
+ * @param lineY Row of the wall's top (may be outside the clipping range)
+ * @param lineLength Height of the wall
+ * @param tex Pixels of the wall's texture
+ * @param texX Column in these pixels
+ * @param clipTop First row that may be drawn
+ * @param clipBottom End of the drawable rows (excluded)
+ * @param shade If the color should be shaded (read from the shaded pixels if any)
+ */
+void drawWallColumn(image::Texture& target, size_t column, double lineY, double lineLength, const image::TextureView& tex, double texX, double clipTop, double clipBottom, bool shade);
+
+/**
+ * @brief Fill rows of a frame buffer column
+ * @param target The frame buffer
+ * @param column Column of the frame buffer (must exist)
+ * @param rowBegin First row (clipped to the frame buffer)
+ * @param rowEnd End row, excluded (clipped to the frame buffer)
+ * @param color The fill color
+ */
+void fillColumn(image::Texture& target, size_t column, int32_t rowBegin, int32_t rowEnd, const Color& color);
+
+}// namespace rc::graphics
@@ -0,0 +1,34 @@
+/**
+ * @file WallSpan.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "WallSpan.h"
+#include <cmath>
+
+namespace rc::graphics {
+
+/// Fixed point coordinate of 1.0
+static constexpr double fixedOne = 4294967296.0;
+
+WallSpan::WallSpan(double lineY, double lineLength, size_t textureHeight, double clipTop, double clipBottom) {
+    if (textureHeight == 0 || lineLength <= 0)
+        return;
+    const double beginCoord = std::max({lineY, clipTop, 0.0});
+    const double endCoord   = std::min(lineY + lineLength, clipBottom);
+    const double length     = endCoord - beginCoord;
+    if (length <= 0)
+        return;
+    const double textureIncrement = static_cast<double>(textureHeight) / lineLength;
+    const double beginTex         = std::max(0.0, -lineY * textureIncrement);
+    m_firstRow                    = static_cast<size_t>(beginCoord);
+    m_count                       = static_cast<size_t>(std::ceil(length));
+    m_start                       = static_cast<FixedType>(std::floor(beginTex * fixedOne));
+    m_step                        = static_cast<FixedType>(std::ceil(textureIncrement * fixedOne));
+    m_lastTextureRow              = textureHeight - 1;
+}
+
+}// namespace rc::graphics
@@ -0,0 +1,108 @@
+/**
+ * @file WallSpan.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace rc::graphics {
+
+/**
+ * @brief Class WallSpan
+ *
+ * Rows of a textured wall column once clipped, and the texture row of each of them.
+ * The texture coordinate is stepped in fixed point: one integer addition and one shift
+ * per pixel instead of a multiplication and a double to integer conversion.
+ *
+ * The start is truncated, which keeps its texture row, and the step is rounded up, so
+ * texel boundaries are reached on the same row as the double computation (floor of
+ * first + pixel * step): the drift stays under rows * 2^-32 texel, far too small to
+ * move a boundary by one row.
+ */
+class WallSpan {
+public:
+    /// Fixed point coordinate: 32 bits of integer part, 32 bits of fractional part
+    using FixedType = uint64_t;
+    /// Number of fractional bits
+    static constexpr uint32_t fractionBits = 32;
+
+    /**
+     * @brief Default copy constructor
+     */
+    WallSpan(const WallSpan&) = default;
+    /**
+     * @brief Default move constructor
+     */
+    WallSpan(WallSpan&&) = default;
+    /**
+     * @brief Default copy assignation
+     * @return this
+     */
+    WallSpan& operator=(const WallSpan&) = default;
+    /**
+     * @brief Default move assignation
+     * @return this
+     */
+    WallSpan& operator=(WallSpan&&) = default;
+    /**
+     * @brief Constructor
+     * @param lineY Row of the wall's top (may be outside the clipping range)
+     * @param lineLength Height of the wall
+     * @param textureHeight Height of the wall's texture
+     * @param clipTop First row that may be drawn
+     * @param clipBottom End of the drawable rows (excluded)
+     */
+    WallSpan(double lineY, double lineLength, size_t textureHeight, double clipTop, double clipBottom);
+    /**
+     * @brief Destructor.
+     */
+    ~WallSpan() = default;
+
+    /**
+     * @brief Check if there is nothing to draw
+     * @return True if no row is visible
+     */
+    [[nodiscard]] bool empty() const { return m_count == 0; }
+    /**
+     * @brief Get the first visible row
+     * @return The row
+     */
+    [[nodiscard]] size_t firstRow() const { return m_firstRow; }
+    /**
+     * @brief Get the amount of visible rows
+     * @return The amount of rows
+     */
+    [[nodiscard]] size_t count() const { return m_count; }
+
+    /**
+     * @brief Call a function for each visible row
+     * @tparam Function Callable as function(pixel, textureRow), pixel counting from the first visible row
+     * @param function The function
+     */
+    template<class Function>
+    void forEach(Function&& function) const {
+        FixedType position = m_start;
+        for (size_t pixel = 0; pixel < m_count; ++pixel, position += m_step)
+            function(pixel, std::min(static_cast<size_t>(position >> fractionBits), m_lastTextureRow));
+    }
+
+private:
+    /// First visible row
+    size_t m_firstRow = 0;
+    /// Amount of visible rows
+    size_t m_count = 0;
+    /// Texture coordinate of the first visible row
+    FixedType m_start = 0;
+    /// Texture coordinate increment per row
+    FixedType m_step = 0;
+    /// Last row of the texture
+    size_t m_lastTextureRow = 0;
+};
+
+}// namespace rc::graphics
@@ -7,6 +7,8 @@
  */
 
 #include "Texture.h"
+#include "graphics/Pixels.h"
+#include <algorithm>
 #include <iostream>
 #include <png.h>
 
@@ -65,25 +67,14 @@ void Texture::readPNG(const DataFile& file) {
     const uint8_t numchannels = png_get_channels(png_ptr, info_ptr);
     // initialie our image storage
     m_pixels.resize(m_height * m_width);
+    m_shaded.clear();
+    m_mipmaps.clear();
     std::vector<png_byte> row(bpr);
+    // rows are converted in bulk, straight into the pixels (a strided write when they are stored by column)
     for (uint16_t irow = 0; irow < m_height; ++irow) {
         png_read_row(png_ptr, row.data(), nullptr);
-        for (uint16_t icol = 0; icol < m_width; ++icol) {
-            auto& pixel = getPixel(icol, irow);
-            if (numchannels == 1) {
-                // monochrome
-                pixel = Color(row[icol], row[icol], row[icol], 255);
-            } else if (numchannels == 2) {
-                // monochrome + alpha
-                pixel = Color(row[2 * icol], row[2 * icol], row[2 * icol], row[2 * icol + 1]);
-            } else if (numchannels == 3) {
-                // RGB
-                pixel = Color(row[3 * icol], row[3 * icol + 1], row[3 * icol + 2], 255);
-            } else if (numchannels == 4) {
-                // RGBA
-                pixel = Color(row[4 * icol], row[4 * icol + 1], row[4 * icol + 2], row[4 * icol + 3]);
-            }
-        }
+        const size_t first = pixelIndex(0, irow);
+        unpackPixels(row, numchannels, std::span(m_pixels).subspan(first), pixelIndex(1, irow) - first);
     }
     // cleanup
     png_read_end(png_ptr, nullptr);
@@ -91,7 +82,7 @@ void Texture::readPNG(const DataFile& file) {
     fclose(pngFile);
 }
 
-void Texture::savePNG(const DataFile& file) {
+void Texture::savePNG(const DataFile& file) const {
     png_FILE_p pngFile = fopen(file.getFullPath().string().c_str(), "wb");
     png_structp png    = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
     png_infop info     = png_create_info_struct(png);
@@ -129,36 +120,86 @@ void Texture::savePNG(const DataFile& file) {
     png_destroy_write_struct(&png, &info);
 }
 
+void Texture::resize(size_t width, size_t height, const Color& color) {
+    m_width  = width;
+    m_height = height;
+    m_pixels.assign(m_width * m_height, color);
+    m_shaded.clear();
+    m_mipmaps.clear();
+}
+
+void Texture::fill(const Color& color) {
+    fillPixels(m_pixels, color);
+    if (hasShadedCopy())
+        fillPixels(m_shaded, color.darker());
+    for (auto& level : m_mipmaps)
+        level.fill(color);
+}
+
+void Texture::setLayout(Layout layout) {
+    if (layout == m_layout)
+        return;
+    const auto transpose = [this, layout](std::vector<Color>& pixels) {
+        if (pixels.empty())
+            return;
+        std::vector<Color> result(pixels.size());
+        for (size_t u = 0; u < m_width; ++u)
+            for (size_t v = 0; v < m_height; ++v)
+                result[layout == Layout::ColumnMajor ? u * m_height + v : v * m_width + u] = pixels[pixelIndex(u, v)];
+        pixels.swap(result);
+    };
+    transpose(m_pixels);
+    transpose(m_shaded);
+    m_layout = layout;
+    for (auto& level : m_mipmaps)
+        level.setLayout(layout);
+}
+
+void Texture::buildShadedCopy() {
+    m_shaded.resize(m_pixels.size());
+    darkenPixels(m_pixels, m_shaded);
+    for (auto& level : m_mipmaps)
+        level.buildShadedCopy();
+}
+
+void Texture::dropShadedCopy() {
+    m_shaded.clear();
+    m_shaded.shrink_to_fit();
+    for (auto& level : m_mipmaps)
+        level.dropShadedCopy();
+}
+
 /// just a dummy color
 static Color dummyColor{0, 0, 0, 0};
 
 const Color& Texture::getPixel(uint16_t u, uint16_t v) const {
     if (u >= width() || v >= height())
         return dummyColor;
-    return m_pixels[u * m_height + v];
+    return m_pixels[pixelIndex(u, v)];
 }
 
 Color& Texture::getPixel(uint16_t u, uint16_t v) {
     if (u >= width() || v >= height())
         return dummyColor;
-    return m_pixels[u * m_height + v];
+    return m_pixels[pixelIndex(u, v)];
 }
 
 Color Texture::getPixel(uint16_t u, uint16_t v, uint16_t radius) const {
     if (u >= width() || v >= height())
         return Color{0, 0, 0, 0};
+    return averagePixels(u > radius ? u - radius : 0U, v > radius ? v - radius : 0U,
+                         std::min<size_t>(u + radius + 1U, width()), std::min<size_t>(v + radius + 1U, height()));
+}
+
+Color Texture::averagePixels(size_t uBegin, size_t vBegin, size_t uEnd, size_t vEnd) const {
     int count = 0;
     double R{0};
     double G{0};
     double B{0};
     double A{0};
-    for (int32_t i = -radius; i <= radius; ++i) {
-        for (int32_t j = -radius; j <= radius; ++j) {
-            if (u + i < 0 || v + j < 0) continue;
-            const auto uu = static_cast<uint16_t>(u + i);
-            const auto vv = static_cast<uint16_t>(v + j);
-            if (uu >= width() || vv >= height()) continue;
-            const auto& Pixel = getPixel(uu,vv);
+    for (size_t uu = uBegin; uu < uEnd; ++uu) {
+        for (size_t vv = vBegin; vv < vEnd; ++vv) {
+            const auto& Pixel = m_pixels[pixelIndex(uu, vv)];
             R += Pixel.redf();
             G += Pixel.greenf();
             B += Pixel.bluef();
@@ -175,4 +216,57 @@ Color Texture::getPixel(uint16_t u, uint16_t v, uint16_t radius) const {
     return Color::fromDouble(R, G, B, A);
 }
 
+void Texture::buildMipmaps() {
+    m_mipmaps.clear();
+    if (m_pixels.empty())
+        return;
+    // levels are built from the previous one: no reallocation may move it
+    size_t levels = 0;
+    for (size_t size = std::max(m_width, m_height); size > 1; size /= 2)
+        ++levels;
+    m_mipmaps.reserve(levels);
+    const Texture* previous = this;
+    while (previous->width() > 1 || previous->height() > 1) {
+        Texture level(std::max<size_t>(previous->width() / 2, 1), std::max<size_t>(previous->height() / 2, 1));
+        level.setLayout(m_layout);
+        for (size_t u = 0; u < level.width(); ++u) {
+            // the last block takes the odd column or row left over
+            const size_t uEnd = u + 1 == level.width() ? previous->width() : 2 * u + 2;
+            for (size_t v = 0; v < level.height(); ++v) {
+                const size_t vEnd                      = v + 1 == level.height() ? previous->height() : 2 * v + 2;
+                level.m_pixels[level.pixelIndex(u, v)] = previous->averagePixels(std::min(2 * u, previous->width() - 1), std::min(2 * v, previous->height() - 1), uEnd, vEnd);
+            }
+        }
+        if (hasShadedCopy())
+            level.buildShadedCopy();
+        m_mipmaps.push_back(std::move(level));
+        previous = &m_mipmaps.back();
+    }
+}
+
+void Texture::dropMipmaps() {
+    m_mipmaps.clear();
+    m_mipmaps.shrink_to_fit();
+}
+
+const Texture& Texture::getMipmap(size_t level) const {
+    if (level == 0 || m_mipmaps.empty())
+        return *this;
+    return m_mipmaps[std::min(level, m_mipmaps.size()) - 1];
+}
+
+const Texture& Texture::getMipmapFor(double drawHeight) const {
+    size_t level = 0;
+    while (level < m_mipmaps.size() && static_cast<double>(m_mipmaps[level].height()) >= drawHeight)
+        ++level;
+    return getMipmap(level);
+}
+
+size_t Texture::memorySize() const {
+    size_t size = (m_pixels.size() + m_shaded.size()) * sizeof(Color);
+    for (const auto& level : m_mipmaps)
+        size += level.memorySize();
+    return size;
+}
+
 }// namespace rc::graphics::image
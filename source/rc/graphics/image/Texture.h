@@ -9,7 +9,9 @@
 #pragma once
 #include "core/fs/DataFile.h"
 #include "graphics/Color.h"
+#include "TextureView.h"
 #include <string>
+#include <vector>
 
 /**
  * @brief Namespace for the images
@@ -18,9 +20,23 @@ namespace rc::graphics::image {
 
 /**
  * @brief Class Texture
+ *
+ * Pixels are stored column-major by default, so the vertical spans of the walls are
+ * contiguous. A texture may also keep a shaded copy of its pixels (see Color::darker)
+ * in the same layout, so drawing shaded walls is a copy too, and a mip chain (successive
+ * half size copies) for the distant walls.
  */
 class Texture {
 public:
+    /// File's type
+    using DataFile = core::fs::DataFile;
+    /**
+     * @brief Storage order of the pixels
+     */
+    enum struct Layout {
+        ColumnMajor,///< Column after column: the vertical spans are contiguous
+        RowMajor    ///< Row after row, like image files
+    };
     /**
      * @brief Default constructor.
      */
@@ -47,6 +63,13 @@ public:
      * @brief Destructor.
      */
     ~Texture() = default;
+    /**
+     * @brief Construct a blank texture by size
+     * @param width Texture's width
+     * @param height Texture's height
+     * @param color Initial color of all pixels
+     */
+    Texture(size_t width, size_t height, const Color& color = {0, 0, 0}) { resize(width, height, color); }
 
     /**
      * @brief Load texture from the file in data
@@ -58,6 +81,107 @@ public:
      * @param textureName Texture's name to save
      */
     void saveToFile(const std::string& textureName);
+    /**
+     * @brief Save texture to the given data file
+     * @param file The destination file
+     */
+    void saveToFile(const DataFile& file) const { savePNG(file); }
+
+    /**
+     * @brief Resize the texture, all pixels are reset
+     * @param width New width
+     * @param height New height
+     * @param color Color of all pixels
+     */
+    void resize(size_t width, size_t height, const Color& color = {0, 0, 0});
+    /**
+     * @brief Fill all the texture with the given color
+     * @param color The fill color
+     */
+    void fill(const Color& color);
+
+    /**
+     * @brief Change the storage order, pixels are reordered
+     * @param layout The new layout
+     */
+    void setLayout(Layout layout);
+    /**
+     * @brief Get the storage order
+     * @return The layout
+     */
+    [[nodiscard]] const Layout& getLayout() const { return m_layout; }
+    /**
+     * @brief Get the index in data() of a pixel
+     * @param u Horizontal coordinate
+     * @param v Vertical coordinate
+     * @return The index
+     */
+    [[nodiscard]] size_t pixelIndex(size_t u, size_t v) const { return m_layout == Layout::ColumnMajor ? u * m_height + v : v * m_width + u; }
+    /**
+     * @brief Get the distance in data() between a pixel and the one below
+     * @return The stride
+     */
+    [[nodiscard]] size_t columnStride() const { return m_layout == Layout::ColumnMajor ? 1 : m_width; }
+    /**
+     * @brief Get a view on the pixels (and the shaded copy), valid until the texture is modified
+     * @return The view
+     */
+    [[nodiscard]] TextureView view() const {
+        return {m_pixels.data(), hasShadedCopy() ? m_shaded.data() : nullptr, m_width, m_height,
+                m_layout == Layout::ColumnMajor ? m_height : 1, columnStride()};
+    }
+
+    /**
+     * @brief Compute the shaded copy of the pixels, to call again after modifying pixels
+     */
+    void buildShadedCopy();
+    /**
+     * @brief Free the shaded copy
+     */
+    void dropShadedCopy();
+    /**
+     * @brief Check for a shaded copy
+     * @return True if there is a shaded copy
+     */
+    [[nodiscard]] bool hasShadedCopy() const { return !m_shaded.empty(); }
+    /**
+     * @brief Access to the shaded copy, with the same layout as data()
+     * @return Pointer to the first shaded pixel (null without shaded copy)
+     */
+    [[nodiscard]] const Color* shadedData() const { return m_shaded.data(); }
+    /**
+     * @brief Compute the mip chain down to 1x1 (2x2 box filter), to call again after modifying pixels
+     *
+     * Levels get a shaded copy if this texture has one.
+     */
+    void buildMipmaps();
+    /**
+     * @brief Free the mip chain
+     */
+    void dropMipmaps();
+    /**
+     * @brief Get the amount of mipmap levels, the texture itself excluded
+     * @return Amount of levels
+     */
+    [[nodiscard]] size_t mipmapCount() const { return m_mipmaps.size(); }
+    /**
+     * @brief Access to a mipmap level
+     * @param level The level: 0 is this texture, each level is half the size of the previous one
+     * @return The level's texture (the smallest one if level is too big)
+     */
+    [[nodiscard]] const Texture& getMipmap(size_t level) const;
+    /**
+     * @brief Get the smallest mipmap level not smaller than a drawing height
+     * @param drawHeight Height of the drawn texture in pixels
+     * @return The level's texture
+     */
+    [[nodiscard]] const Texture& getMipmapFor(double drawHeight) const;
+
+    /**
+     * @brief Get the memory used by the pixels, shaded copy and mip chain included
+     * @return Size in bytes
+     */
+    [[nodiscard]] size_t memorySize() const;
 
     /**
      * @brief Get texture's width
@@ -96,21 +220,51 @@ public:
     [[nodiscard]] Color& getPixel(uint16_t u, uint16_t v);
 
     /**
-     * @brief Get iterator to the begin of the column
+     * @brief Get iterator to the begin of the column (column-major layout only)
      * @param col Column's index
      * @return Iterator to the column
      */
     [[nodiscard]] std::vector<Color>::const_iterator getPixelColumn(uint16_t col)const{
         return m_pixels.begin() + (static_cast<long long int>(col * m_height));
     }
+    /**
+     * @brief Get iterator to the begin of the column (column-major layout only)
+     * @param col Column's index
+     * @return Iterator to the column
+     */
+    [[nodiscard]] std::vector<Color>::iterator getPixelColumn(uint16_t col){
+        return m_pixels.begin() + (static_cast<long long int>(col * m_height));
+    }
+    /**
+     * @brief Access to the raw pixels, in the texture's layout
+     * @return Pointer to the first pixel
+     */
+    [[nodiscard]] const Color* data() const { return m_pixels.data(); }
+    /**
+     * @brief Access to the raw pixels, in the texture's layout
+     * @return Pointer to the first pixel
+     */
+    [[nodiscard]] Color* data() { return m_pixels.data(); }
 private:
-    using DataFile = core::fs::DataFile;
     size_t m_width  = 0;
     size_t m_height = 0;
     std::vector<Color> m_pixels;
+    std::vector<Color> m_shaded;
+    Layout m_layout = Layout::ColumnMajor;
+    std::vector<Texture> m_mipmaps;
+
+    /**
+     * @brief Get the mean color of a block of pixels
+     * @param uBegin First column
+     * @param vBegin First row
+     * @param uEnd End column (excluded)
+     * @param vEnd End row (excluded)
+     * @return Mean color, transparent if mostly transparent, else opaque
+     */
+    [[nodiscard]] Color averagePixels(size_t uBegin, size_t vBegin, size_t uEnd, size_t vEnd) const;
 
     void readPNG(const DataFile& file);
-    void savePNG(const DataFile& file);
+    void savePNG(const DataFile& file) const;
 };
 
 }// namespace rc::graphics::image
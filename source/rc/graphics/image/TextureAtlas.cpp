@@ -0,0 +1,82 @@
+/**
+ * @file TextureAtlas.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "TextureAtlas.h"
+
+namespace rc::graphics::image {
+
+/// View of the unused slots
+static const TextureView emptyView{};
+
+void TextureAtlas::clear() {
+    m_pixels.clear();
+    m_levels.clear();
+    m_views.clear();
+    m_slots.fill({});
+}
+
+void TextureAtlas::add(size_t slot, const Texture& texture) {
+    if (slot >= slotCount || contains(slot) || texture.width() == 0 || texture.height() == 0)
+        return;
+    const size_t levels = texture.mipmapCount() + 1;
+    // one reallocation for the whole texture
+    size_t pixelCount = 0;
+    for (size_t level = 0; level < levels; ++level) {
+        const auto& tex = texture.getMipmap(level);
+        pixelCount += tex.width() * tex.height() * (tex.hasShadedCopy() ? 2 : 1);
+    }
+    m_pixels.reserve(m_pixels.size() + pixelCount);
+    m_slots[slot] = {m_levels.size(), levels};
+    const auto copy = [this](const Texture& tex, const Color* source) {
+        if (tex.columnStride() == 1) {
+            m_pixels.insert(m_pixels.end(), source, source + tex.width() * tex.height());
+            return;
+        }
+        for (size_t u = 0; u < tex.width(); ++u)
+            for (size_t v = 0; v < tex.height(); ++v)
+                m_pixels.push_back(source[tex.pixelIndex(u, v)]);
+    };
+    for (size_t level = 0; level < levels; ++level) {
+        const auto& tex = texture.getMipmap(level);
+        Level place{m_pixels.size(), 0, tex.hasShadedCopy(), tex.width(), tex.height()};
+        copy(tex, tex.data());
+        if (place.shaded) {
+            place.shadedOffset = m_pixels.size();
+            copy(tex, tex.shadedData());
+        }
+        m_levels.push_back(place);
+    }
+    updateViews();
+}
+
+void TextureAtlas::updateViews() {
+    m_views.clear();
+    m_views.reserve(m_levels.size());
+    for (const auto& level : m_levels)
+        m_views.push_back({m_pixels.data() + level.offset, level.shaded ? m_pixels.data() + level.shadedOffset : nullptr,
+                           level.width, level.height, level.height, 1});
+}
+
+const TextureView& TextureAtlas::getView(size_t slot, size_t level) const {
+    if (!contains(slot))
+        return emptyView;
+    const auto& place = m_slots[slot];
+    return m_views[place.firstLevel + std::min(level, place.levelCount - 1)];
+}
+
+const TextureView& TextureAtlas::getViewFor(size_t slot, double drawHeight) const {
+    if (!contains(slot))
+        return emptyView;
+    const auto& place = m_slots[slot];
+    size_t level      = 0;
+    while (level + 1 < place.levelCount && static_cast<double>(m_views[place.firstLevel + level + 1].height) >= drawHeight)
+        ++level;
+    return m_views[place.firstLevel + level];
+}
+
+}// namespace rc::graphics::image
@@ -0,0 +1,134 @@
+/**
+ * @file TextureAtlas.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Texture.h"
+#include <array>
+
+namespace rc::graphics::image {
+
+/**
+ * @brief Class TextureAtlas
+ *
+ * The wall textures of a level packed in one contiguous block, found by slot (the map
+ * cells' texture ID): a wall column gets its pixels with an array access instead of a
+ * texture name lookup. Each slot holds the texture's mip chain and shaded copies, if
+ * it had some, stored column-major. The block can be uploaded at once to a GPU.
+ */
+class TextureAtlas {
+public:
+    /// Amount of slots: the 6 bits texture ID of the map cells
+    static constexpr size_t slotCount = 64;
+
+    TextureAtlas(const TextureAtlas&)            = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+    /**
+     * @brief Default move constructor
+     */
+    TextureAtlas(TextureAtlas&&) = default;
+    /**
+     * @brief Default move assignation
+     * @return this
+     */
+    TextureAtlas& operator=(TextureAtlas&&) = default;
+    /**
+     * @brief Default constructor.
+     */
+    TextureAtlas() = default;
+    /**
+     * @brief Destructor.
+     */
+    ~TextureAtlas() = default;
+
+    /**
+     * @brief Empty the atlas
+     */
+    void clear();
+    /**
+     * @brief Copy a texture with its mip chain and shaded copies in a slot
+     * @param slot The slot (ignored if already used or out of range)
+     * @param texture The texture
+     */
+    void add(size_t slot, const Texture& texture);
+    /**
+     * @brief Check if a slot is used
+     * @param slot The slot
+     * @return True if the slot holds a texture
+     */
+    [[nodiscard]] bool contains(size_t slot) const { return slot < slotCount && m_slots[slot].levelCount > 0; }
+    /**
+     * @brief Get the amount of mipmap levels of a slot, full size level included
+     * @param slot The slot
+     * @return The amount of levels
+     */
+    [[nodiscard]] size_t levelCount(size_t slot) const { return slot < slotCount ? m_slots[slot].levelCount : 0; }
+    /**
+     * @brief Get the pixels of a slot
+     * @param slot The slot
+     * @param level The mipmap level (clamped to the last one)
+     * @return The pixels (empty if the slot is not used)
+     */
+    [[nodiscard]] const TextureView& getView(size_t slot, size_t level = 0) const;
+    /**
+     * @brief Get the smallest level of a slot still taller than a drawn line, as Texture::getMipmapFor
+     * @param slot The slot
+     * @param drawHeight Height of the line on screen in pixels
+     * @return The pixels (empty if the slot is not used)
+     */
+    [[nodiscard]] const TextureView& getViewFor(size_t slot, double drawHeight) const;
+
+    /**
+     * @brief Access to the whole block
+     * @return Pointer to the first pixel
+     */
+    [[nodiscard]] const Color* data() const { return m_pixels.data(); }
+    /**
+     * @brief Get the amount of pixels in the block
+     * @return The amount of pixels
+     */
+    [[nodiscard]] size_t size() const { return m_pixels.size(); }
+    /**
+     * @brief Get the memory used by the block
+     * @return Size in bytes
+     */
+    [[nodiscard]] size_t memorySize() const { return m_pixels.size() * sizeof(Color); }
+
+private:
+    /**
+     * @brief Place of a level in the block
+     */
+    struct Level {
+        size_t offset       = 0;///< First pixel
+        size_t shadedOffset = 0;///< First shaded pixel (if any)
+        bool shaded         = false;///< If there are shaded pixels
+        size_t width        = 0;///< Width in pixels
+        size_t height       = 0;///< Height in pixels
+    };
+    /**
+     * @brief Levels of a slot
+     */
+    struct Slot {
+        size_t firstLevel = 0;///< Index of the full size level
+        size_t levelCount = 0;///< Amount of levels
+    };
+    /**
+     * @brief Rebuild the views after the block moved
+     */
+    void updateViews();
+
+    /// The pixels of all textures
+    std::vector<Color> m_pixels;
+    /// Places of the levels
+    std::vector<Level> m_levels;
+    /// Views on the levels
+    std::vector<TextureView> m_views;
+    /// The slots
+    std::array<Slot, slotCount> m_slots{};
+};
+
+}// namespace rc::graphics::image
@@ -0,0 +1,87 @@
+/**
+ * @file TextureLoader.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "TextureLoader.h"
+#include "core/fs/DataFile.h"
+#include <algorithm>
+
+namespace rc::graphics::image {
+
+TextureLoader::TextureLoader(size_t threads) {
+    // the data path is searched on first use: do it before the threads may race for it
+    [[maybe_unused]] const auto dataPath = core::fs::DataFile::getDataPath();
+    m_threads.reserve(std::max<size_t>(threads, 1));
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+        m_threads.emplace_back([this] { work(); });
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        const std::lock_guard lock(m_mutex);
+        m_stop = true;
+        m_requests.clear();
+    }
+    m_wakeUp.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+void TextureLoader::push(Request request) {
+    {
+        const std::lock_guard lock(m_mutex);
+        m_requests.push_back(std::move(request));
+    }
+    m_wakeUp.notify_one();
+}
+
+void TextureLoader::takeResults(std::vector<Result>& results) {
+    results.clear();
+    const std::lock_guard lock(m_mutex);
+    std::swap(results, m_results);
+}
+
+void TextureLoader::wait() {
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return m_requests.empty() && m_working == 0; });
+}
+
+size_t TextureLoader::pending() const {
+    const std::lock_guard lock(m_mutex);
+    return m_requests.size() + m_working;
+}
+
+Texture TextureLoader::load(const Request& request) {
+    Texture texture;
+    texture.loadFromFile(request.name);
+    if (request.mipmaps)
+        texture.buildMipmaps();
+    if (request.shaded)
+        texture.buildShadedCopy();
+    return texture;
+}
+
+void TextureLoader::work() {
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_wakeUp.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+        if (m_stop)
+            return;
+        Request request = std::move(m_requests.front());
+        m_requests.pop_front();
+        ++m_working;
+        lock.unlock();
+        Texture texture = load(request);
+        const auto loaded = clock::now();
+        lock.lock();
+        m_results.push_back({std::move(request), std::move(texture), loaded});
+        --m_working;
+        m_done.notify_all();
+    }
+}
+
+}// namespace rc::graphics::image
@@ -0,0 +1,130 @@
+/**
+ * @file TextureLoader.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Texture.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rc::graphics::image {
+
+/**
+ * @brief Class TextureLoader
+ *
+ * Pool of threads decoding textures in the background. Requests are processed in order;
+ * the decoded textures are collected by the owner thread with takeResults. The loader
+ * never touches its owner's data: a request carries all it needs.
+ */
+class TextureLoader {
+public:
+    /// Clock used to measure the load latency
+    using clock = std::chrono::steady_clock;
+    /**
+     * @brief Texture to decode
+     */
+    struct Request {
+        /// Texture's name
+        std::string name;
+        /// Owner's identifier of the texture
+        uint32_t index = 0;
+        /// Owner's state when requested, to drop results made obsolete meanwhile
+        uint64_t generation = 0;
+        /// If the mip chain is built
+        bool mipmaps = false;
+        /// If the shaded copy is built
+        bool shaded = false;
+        /// Time of the request
+        clock::time_point requested;
+    };
+    /**
+     * @brief Decoded texture
+     */
+    struct Result {
+        /// The request
+        Request request;
+        /// The texture
+        Texture texture;
+        /// Time the texture got ready
+        clock::time_point loaded;
+    };
+
+    TextureLoader(const TextureLoader&)            = delete;
+    TextureLoader(TextureLoader&&)                 = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+    TextureLoader& operator=(TextureLoader&&)      = delete;
+    /**
+     * @brief Constructor, starts the threads
+     * @param threads Amount of threads (at least one)
+     */
+    explicit TextureLoader(size_t threads);
+    /**
+     * @brief Destructor, pending requests are dropped and the threads joined
+     */
+    ~TextureLoader();
+
+    /**
+     * @brief Queue a texture to decode
+     * @param request The request
+     */
+    void push(Request request);
+    /**
+     * @brief Move the decoded textures out
+     * @param results Receives the results (cleared first, its capacity is reused)
+     */
+    void takeResults(std::vector<Result>& results);
+    /**
+     * @brief Wait until all the queued requests are decoded
+     */
+    void wait();
+    /**
+     * @brief Get the amount of requests not decoded yet
+     * @return Amount of requests
+     */
+    [[nodiscard]] size_t pending() const;
+    /**
+     * @brief Get the amount of threads
+     * @return Amount of threads
+     */
+    [[nodiscard]] size_t threadCount() const { return m_threads.size(); }
+
+    /**
+     * @brief Decode a texture, as the threads do
+     * @param request The request
+     * @return The texture, with its mip chain and shaded copy if requested
+     */
+    static Texture load(const Request& request);
+
+private:
+    /**
+     * @brief Thread's loop
+     */
+    void work();
+
+    /// Protects the queues
+    mutable std::mutex m_mutex;
+    /// Signals a new request or the stop
+    std::condition_variable m_wakeUp;
+    /// Signals a decoded texture
+    std::condition_variable m_done;
+    /// Requests not taken yet
+    std::deque<Request> m_requests;
+    /// Decoded textures not collected yet
+    std::vector<Result> m_results;
+    /// Requests taken and being decoded
+    size_t m_working = 0;
+    /// If the threads must exit
+    bool m_stop = false;
+    /// The threads
+    std::vector<std::thread> m_threads;
+};
+
+}// namespace rc::graphics::image
@@ -8,7 +8,6 @@
 
 #include "TextureManager.h"
 #include <algorithm>
-#include <vector>
 
 namespace rc::graphics::image {
 
@@ -16,51 +15,248 @@ namespace rc::graphics::image {
  * @brief a void texture
  */
 static Texture dummyTex;
+/**
+ * @brief Texture drawn while the real one is loaded in the background
+ */
+static const Texture placeholderTex{1, 1, {128, 128, 128}};
+
+TextureHandle TextureManager::getHandle(const std::string& name) {
+    if (name.empty()) return {};
+    const auto [it, inserted] = m_handles.try_emplace(name, TextureHandle{static_cast<uint32_t>(m_textures.size())});
+    if (inserted)
+        m_textures.emplace_back().m_name = name;
+    return it->second;
+}
+
+const Texture& TextureManager::getTexture(TextureHandle handle) {
+    if (handle.index >= m_textures.size()) return dummyTex;
+    touch(handle.index);
+    auto& info = m_textures[handle.index];
+    if (info.m_loaded)
+        return info.m_texture;
+    if (!m_loader)
+        ++m_stats.hitches;
+    loadTexture(handle.index);
+    if (m_loader) {
+        ++m_stats.placeholders;
+        return placeholderTex;
+    }
+    return info.m_texture;
+}
+
+void TextureManager::prefetch(TextureHandle handle) {
+    if (handle.index >= m_textures.size()) return;
+    touch(handle.index);
+    if (!m_textures[handle.index].m_loaded)
+        loadTexture(handle.index);
+}
+
+void TextureManager::pin(TextureHandle handle) {
+    if (handle.index >= m_textures.size()) return;
+    auto& info = m_textures[handle.index];
+    if (info.m_pinned)
+        return;
+    if (info.m_loaded)
+        unlink(handle.index);
+    info.m_pinned = true;
+    if (!info.m_loaded)
+        loadTexture(handle.index);
+}
+
+void TextureManager::unpin(TextureHandle handle) {
+    if (handle.index >= m_textures.size()) return;
+    auto& info = m_textures[handle.index];
+    if (!info.m_pinned)
+        return;
+    info.m_pinned = false;
+    if (info.m_loaded) {
+        link(handle.index);
+        memoryCheck();
+    }
+}
+
+void TextureManager::touch(uint32_t index) {
+    auto& info = m_textures[index];
+    if (info.m_lastUse > m_frameStart) // already used in this frame
+        return;
+    info.m_lastUse = ++m_useCounter;
+    if (info.m_loaded && !info.m_pinned && index != m_newest) {
+        unlink(index);
+        link(index);
+    }
+}
+
+void TextureManager::link(uint32_t index) {
+    auto& info      = m_textures[index];
+    info.m_previous = m_newest;
+    info.m_next     = noTexture;
+    if (m_newest != noTexture)
+        m_textures[m_newest].m_next = index;
+    else
+        m_oldest = index;
+    m_newest = index;
+}
+
+void TextureManager::unlink(uint32_t index) {
+    auto& info = m_textures[index];
+    if (info.m_previous != noTexture)
+        m_textures[info.m_previous].m_next = info.m_next;
+    else
+        m_oldest = info.m_next;
+    if (info.m_next != noTexture)
+        m_textures[info.m_next].m_previous = info.m_previous;
+    else
+        m_newest = info.m_previous;
+    info.m_previous = info.m_next = noTexture;
+}
 
-const Texture& TextureManager::getTexture(const std::string& name) {
-    if (name.empty()) return dummyTex;
-    if (m_textures.contains(name)) { // texture already loaded
-        m_textures[name].m_lastCalled = texClock::now(); // update the touch time
-        return m_textures[name].m_texture;
+void TextureManager::loadTexture(uint32_t index) {
+    auto& info = m_textures[index];
+    if (m_loader) {
+        if (!info.m_requested) {
+            info.m_requested = true;
+            m_loader->push({info.m_name, index, m_generation, m_mipmaps, m_shadedCopies, TextureLoader::clock::now()});
+        }
+        return;
     }
-    loadTexture(name);
-    m_textures[name].m_lastCalled = texClock::now(); // update the touch time
-    return m_textures[name].m_texture;
+    const auto start = TextureLoader::clock::now();
+    addTexture(index, TextureLoader::load({info.m_name, index, m_generation, m_mipmaps, m_shadedCopies, start}), TextureLoader::clock::now() - start);
 }
 
-void TextureManager::loadTexture(const std::string& name) {
-    auto& tex = m_textures[name].m_texture;
-    m_textures[name].m_lastCalled = texClock ::now();
-    tex.loadFromFile(name);
-    m_MemoryUsage += tex.height() * tex.width() * 4 + sizeof(Texture);
+void TextureManager::addTexture(uint32_t index, Texture&& texture, TextureLoader::clock::duration latency) {
+    auto& info       = m_textures[index];
+    info.m_texture   = std::move(texture);
+    info.m_loaded    = true;
+    info.m_requested = false;
+    info.m_memory    = 0;
+    ++m_loadedCount;
+    updateMemory(info);
+    if (!info.m_pinned)
+        link(index);
+    const double milliseconds = std::chrono::duration<double, std::milli>(latency).count();
+    ++m_stats.loads;
+    m_stats.totalLatency += milliseconds;
+    m_stats.maxLatency = std::max(m_stats.maxLatency, milliseconds);
     memoryCheck();
 }
 
-void TextureManager::unloadTexture(const std::string& name) {
-    const auto& tex = m_textures[name].m_texture;
-    m_MemoryUsage -= tex.height() * tex.width() * 4 + sizeof(Texture);
-    m_textures.erase(name);
+void TextureManager::collectLoads() {
+    if (!m_loader)
+        return;
+    m_loader->takeResults(m_decoded);
+    for (auto& result : m_decoded) {
+        const auto& request = result.request;
+        // dropped by unloadAll since the request
+        if (request.generation != m_generation || m_textures[request.index].m_loaded)
+            continue;
+        // options changed since the request
+        if (request.mipmaps != m_mipmaps) {
+            if (m_mipmaps)
+                result.texture.buildMipmaps();
+            else
+                result.texture.dropMipmaps();
+        }
+        if (request.shaded != m_shadedCopies) {
+            if (m_shadedCopies)
+                result.texture.buildShadedCopy();
+            else
+                result.texture.dropShadedCopy();
+        }
+        addTexture(request.index, std::move(result.texture), result.loaded - request.requested);
+    }
+    m_decoded.clear();
+}
+
+void TextureManager::newFrame() {
+    m_frameStart = m_useCounter;
+    collectLoads();
+}
+
+void TextureManager::waitForLoads() {
+    if (!m_loader)
+        return;
+    m_loader->wait();
+    collectLoads();
+}
+
+void TextureManager::setLoaderThreads(size_t threads) {
+    if (threads == getLoaderThreads())
+        return;
+    // the requests in progress are finished by the current loader
+    waitForLoads();
+    m_loader.reset();
+    if (threads > 0)
+        m_loader = std::make_unique<TextureLoader>(threads);
+}
+
+void TextureManager::updateMemory(TextureInfo& info) {
+    m_MemoryUsage -= info.m_memory;
+    info.m_memory = info.m_texture.memorySize() + sizeof(Texture);
+    m_MemoryUsage += info.m_memory;
+}
+
+void TextureManager::unloadTexture(uint32_t index) {
+    auto& info = m_textures[index];
+    if (!info.m_pinned)
+        unlink(index);
+    m_MemoryUsage -= info.m_memory;
+    info.m_memory  = 0;
+    info.m_texture = Texture{};
+    info.m_loaded  = false;
+    --m_loadedCount;
 }
 
 void TextureManager::memoryCheck() {
-    if (m_MemoryUsage <= m_MemoryLimit)
+    // pinned textures are not in the chain: they may keep the memory over the limit
+    while (m_MemoryUsage > m_MemoryLimit && m_oldest != noTexture)
+        unloadTexture(m_oldest);
+}
+
+void TextureManager::setShadedCopies(bool shaded) {
+    if (shaded == m_shadedCopies)
+        return;
+    m_shadedCopies = shaded;
+    for (auto& info : m_textures) {
+        if (!info.m_loaded)
+            continue;
+        if (shaded)
+            info.m_texture.buildShadedCopy();
+        else
+            info.m_texture.dropShadedCopy();
+        updateMemory(info);
+    }
+    memoryCheck();
+}
+
+void TextureManager::setMipmaps(bool mipmaps) {
+    if (mipmaps == m_mipmaps)
         return;
-    // Sort texture names by last access time (oldest first)
-    std::vector<std::string> sortedNames;
-    sortedNames.reserve(m_textures.size());
-    for (const auto& [name, data] : m_textures)
-        sortedNames.push_back(name);
-    std::sort(sortedNames.begin(), sortedNames.end(),
-              [this](const auto& l, const auto& r) { return m_textures[l].m_lastCalled < m_textures[r].m_lastCalled; });
-    for (const auto& name : sortedNames) {
-        if (m_MemoryUsage <= m_MemoryLimit)
-            break;
-        unloadTexture(name);
+    m_mipmaps = mipmaps;
+    for (auto& info : m_textures) {
+        if (!info.m_loaded)
+            continue;
+        if (mipmaps)
+            info.m_texture.buildMipmaps();
+        else
+            info.m_texture.dropMipmaps();
+        updateMemory(info);
     }
+    memoryCheck();
 }
 
 void TextureManager::unloadAll() {
-    m_textures.clear();
+    // the names and pins are kept: the handles stay valid
+    for (auto& info : m_textures) {
+        info.m_texture   = Texture{};
+        info.m_memory    = 0;
+        info.m_previous  = noTexture;
+        info.m_next      = noTexture;
+        info.m_loaded    = false;
+        info.m_requested = false;
+    }
+    m_oldest = m_newest = noTexture;
+    ++m_generation;
+    m_loadedCount = 0;
     m_MemoryUsage = 0;
 }
 
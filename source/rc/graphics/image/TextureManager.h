@@ -8,11 +8,50 @@
 
 #pragma once
 #include "Texture.h"
+#include "TextureLoader.h"
+#include <deque>
+#include <memory>
+#include <unordered_map>
 
 namespace rc::graphics::image {
 
+/**
+ * @brief Handle on a texture of the TextureManager
+ *
+ * Resolved once from the texture's name, then a direct index in the manager: valid for
+ * the manager's whole life, even when the texture gets unloaded (it is reloaded on use).
+ */
+struct TextureHandle {
+    /// Value of a handle on no texture
+    static constexpr uint32_t invalid = ~0U;
+    /// Index of the texture in the manager
+    uint32_t index = invalid;
+    /**
+     * @brief Check if the handle refers to a texture
+     * @return True if valid
+     */
+    [[nodiscard]] bool isValid() const { return index != invalid; }
+    /**
+     * @brief Comparison operator
+     * @param other Other handle
+     * @return True if same texture
+     */
+    [[nodiscard]] bool operator==(const TextureHandle& other) const = default;
+};
+
 /**
  * @brief Class TextureManager
+ *
+ * Textures are loaded on first use and unloaded, least recently used first, when their
+ * memory exceeds the limit. The loaded textures are chained in use order through their
+ * entries: a use moves the texture to the end of the chain, an eviction takes the first
+ * one, both in constant time. A use is recorded at most once per texture and per frame
+ * (see newFrame): looking a texture up many times in a frame costs an index. Pinned
+ * textures are left out of the chain and never evicted.
+ *
+ * By default a texture is decoded when first drawn, stalling the frame. With loader
+ * threads (see setLoaderThreads), it is decoded in the background and a placeholder is
+ * drawn meanwhile; the decoded textures are taken in at the start of the frames.
  */
 class TextureManager {
 public:
@@ -34,11 +73,99 @@ public:
     }
 
     /**
-     * @brief Get the texture
+     * @brief Get the handle of a texture, without loading it
+     * @param name Texture's name
+     * @return The handle (invalid for an empty name)
+     */
+    TextureHandle getHandle(const std::string& name);
+    /**
+     * @brief Get the texture, loaded if needed
+     * @param handle Texture's handle
+     * @return The texture (empty for an invalid handle)
+     */
+    const Texture& getTexture(TextureHandle handle);
+    /**
+     * @brief Get the texture, loaded if needed
      * @param name Texture's name
      * @return The texture
      */
-    const Texture& getTexture(const std::string& name);
+    const Texture& getTexture(const std::string& name) { return getTexture(getHandle(name)); }
+    /**
+     * @brief Check if a texture is in memory
+     * @param handle Texture's handle
+     * @return True if loaded
+     */
+    [[nodiscard]] bool isLoaded(TextureHandle handle) const { return handle.index < m_textures.size() && m_textures[handle.index].m_loaded; }
+    /**
+     * @brief Start a new frame: least recently used bookkeeping, take in the textures decoded in the background
+     */
+    void newFrame();
+    /**
+     * @brief Start loading a texture before its first use, without counting a hitch
+     * @param handle Texture's handle
+     */
+    void prefetch(TextureHandle handle);
+    /**
+     * @brief Keep a texture in memory until unpinned (loaded if needed)
+     * @param handle Texture's handle
+     */
+    void pin(TextureHandle handle);
+    /**
+     * @brief Let a texture be evicted again
+     * @param handle Texture's handle
+     */
+    void unpin(TextureHandle handle);
+    /**
+     * @brief Check if a texture is pinned
+     * @param handle Texture's handle
+     * @return True if pinned
+     */
+    [[nodiscard]] bool isPinned(TextureHandle handle) const { return handle.index < m_textures.size() && m_textures[handle.index].m_pinned; }
+    /**
+     * @brief Wait for the textures being loaded in the background, and take them in
+     */
+    void waitForLoads();
+
+    /**
+     * @brief Define the amount of threads loading the textures in the background
+     * @param threads Amount of threads, 0 to load the textures when first drawn
+     */
+    void setLoaderThreads(size_t threads);
+    /**
+     * @brief Get the amount of threads loading the textures in the background
+     * @return Amount of threads
+     */
+    [[nodiscard]] size_t getLoaderThreads() const { return m_loader ? m_loader->threadCount() : 0; }
+
+    /**
+     * @brief Texture loading statistics
+     */
+    struct LoadingStats {
+        /// Textures decoded in a frame, when first drawn
+        size_t hitches = 0;
+        /// Lookups answered with the placeholder
+        size_t placeholders = 0;
+        /// Textures loaded
+        size_t loads = 0;
+        /// Sum of the load latencies (request to ready) in milliseconds
+        double totalLatency = 0;
+        /// Longest load latency in milliseconds
+        double maxLatency = 0;
+        /**
+         * @brief Get the mean load latency
+         * @return Latency in milliseconds
+         */
+        [[nodiscard]] double meanLatency() const { return loads == 0 ? 0.0 : totalLatency / static_cast<double>(loads); }
+    };
+    /**
+     * @brief Get the texture loading statistics
+     * @return The statistics
+     */
+    [[nodiscard]] const LoadingStats& getLoadingStats() const { return m_stats; }
+    /**
+     * @brief Reset the texture loading statistics
+     */
+    void resetLoadingStats() { m_stats = {}; }
 
     /**
      * @brief unload all textures
@@ -49,7 +176,7 @@ public:
      * @brief Get the loaded texture amount
      * @return Count of loaded texture
      */
-    uint16_t getLoadedTextureCount()const{return static_cast<uint16_t>(m_textures.size());}
+    uint16_t getLoadedTextureCount()const{return static_cast<uint16_t>(m_loadedCount);}
 
     /**
      * @brief Get the percentage of used memory
@@ -67,52 +194,147 @@ public:
      * @param limit the new limit
      */
     void setMemoryLimit(size_t limit){m_MemoryLimit=limit;}
+    /**
+     * @brief Get the memory used by the loaded textures
+     * @return Used memory in bytes
+     */
+    const size_t& getMemoryUsage()const{return m_MemoryUsage;}
+
+    /**
+     * @brief Define if the textures keep a shaded copy (faster shaded walls, twice the memory)
+     * @param shaded If shaded copies are kept, applied to the loaded textures too
+     */
+    void setShadedCopies(bool shaded);
+    /**
+     * @brief Check if the textures keep a shaded copy
+     * @return True if shaded copies are kept
+     */
+    [[nodiscard]] bool hasShadedCopies()const{return m_shadedCopies;}
+    /**
+     * @brief Define if the textures keep a mip chain (lighter distant walls, a third more memory)
+     * @param mipmaps If mip chains are kept, applied to the loaded textures too
+     */
+    void setMipmaps(bool mipmaps);
+    /**
+     * @brief Check if the textures keep a mip chain
+     * @return True if mip chains are kept
+     */
+    [[nodiscard]] bool hasMipmaps()const{return m_mipmaps;}
 private:
     /**
      * @brief Default constructor.
      */
     TextureManager() = default;
 
-
-    using texClock = std::chrono::steady_clock;
-    using texTime  = texClock::time_point;
-
     /// Limit memory usage
     size_t m_MemoryLimit = 1073741824;
     /// Current memory
     size_t m_MemoryUsage = 0;
+    /// If the textures keep a shaded copy
+    bool m_shadedCopies = false;
+    /// If the textures keep a mip chain
+    bool m_mipmaps = false;
+
+    /// Use stamp at the start of the frame
+    uint64_t m_frameStart = 0;
+    /// Last use stamp given
+    uint64_t m_useCounter = 0;
+    /// Amount of loaded textures
+    size_t m_loadedCount = 0;
+    /// Incremented when all textures are dropped: older background loads are discarded
+    uint64_t m_generation = 0;
+    /// Background loader (null when loading in the frames)
+    std::unique_ptr<TextureLoader> m_loader;
+    /// Decoded textures being taken in, kept to reuse its memory
+    std::vector<TextureLoader::Result> m_decoded;
+    /// Texture loading statistics
+    LoadingStats m_stats;
+
+    /// Index of no texture in the use chain
+    static constexpr uint32_t noTexture = ~0U;
+    /// Least recently used evictable texture
+    uint32_t m_oldest = noTexture;
+    /// Most recently used evictable texture
+    uint32_t m_newest = noTexture;
 
     /**
      * @brief Structure holding info on texture
      */
     struct TextureInfo {
-        ///
-        texTime m_lastCalled;
+        /// Texture's name
+        std::string m_name;
+        /// Use stamp of the last frame the texture was used in
+        uint64_t m_lastUse = 0;
+        /// Memory counted for the texture while loaded
+        size_t m_memory = 0;
+        /// Previous texture in the use chain (used earlier)
+        uint32_t m_previous = noTexture;
+        /// Next texture in the use chain (used later)
+        uint32_t m_next = noTexture;
+        /// If the texture is in memory
+        bool m_loaded = false;
+        /// If the texture is being loaded in the background
+        bool m_requested = false;
+        /// If the texture may not be evicted
+        bool m_pinned = false;
         /// The texture
         Texture m_texture;
     };
 
     /**
-     * @brief Load the texture
-     * @param name Texture's name
+     * @brief Record a use of the texture, at most once per frame
+     * @param index Texture's index
      */
-    void loadTexture(const std::string& name);
+    void touch(uint32_t index);
+    /**
+     * @brief Add a texture at the end of the use chain
+     * @param index Texture's index
+     */
+    void link(uint32_t index);
+    /**
+     * @brief Remove a texture from the use chain
+     * @param index Texture's index
+     */
+    void unlink(uint32_t index);
+    /**
+     * @brief Load the texture, or request it to the background loader
+     * @param index Texture's index
+     */
+    void loadTexture(uint32_t index);
+    /**
+     * @brief Put a loaded texture in memory
+     * @param index Texture's index
+     * @param texture The texture
+     * @param latency Time since the load request
+     */
+    void addTexture(uint32_t index, Texture&& texture, TextureLoader::clock::duration latency);
+    /**
+     * @brief Take in the textures decoded in the background
+     */
+    void collectLoads();
+    /**
+     * @brief Count again the memory of a loaded texture after a change
+     * @param info Texture's info
+     */
+    void updateMemory(TextureInfo& info);
 
     /**
      * @brief Unload the texture
-     * @param name Texture's name
+     * @param index Texture's index
      */
-    void unloadTexture(const std::string& name);
+    void unloadTexture(uint32_t index);
 
     /**
-     * @brief Check actual memory
+     * @brief Evict the least recently used textures until the memory fits the limit
      */
     void memoryCheck();
 
     /**
-     * @brief The textures al ready loaded
+     * @brief The textures by handle, loaded or not (a deque: references stay valid when it grows)
      */
-    std::unordered_map<std::string, TextureInfo> m_textures;
+    std::deque<TextureInfo> m_textures;
+    /// Handle of each known texture name
+    std::unordered_map<std::string, TextureHandle> m_handles;
 };
 
 }// namespace rc::graphics::image
@@ -0,0 +1,41 @@
+/**
+ * @file TextureView.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "graphics/Color.h"
+#include <cstddef>
+
+namespace rc::graphics::image {
+
+/**
+ * @brief Non owning access to the pixels of a texture (or of one of its mipmap levels)
+ *
+ * What the wall rasterizer reads: the pixels may belong to a Texture or to a TextureAtlas.
+ */
+struct TextureView {
+    /// First pixel, pixel (u, v) being at u * rowStride + v * columnStride
+    const Color* pixels = nullptr;
+    /// Same pixels darkened, with the same layout (null if none)
+    const Color* shaded = nullptr;
+    /// Width in pixels
+    size_t width = 0;
+    /// Height in pixels
+    size_t height = 0;
+    /// Distance between a pixel and the one on its right
+    size_t rowStride = 0;
+    /// Distance between a pixel and the one below
+    size_t columnStride = 0;
+
+    /**
+     * @brief Check if there is no pixel
+     * @return True if empty
+     */
+    [[nodiscard]] bool empty() const { return width == 0 || height == 0; }
+};
+
+}// namespace rc::graphics::image
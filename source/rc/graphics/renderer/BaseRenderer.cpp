@@ -17,12 +17,16 @@ void Settings::fromJson(const nlohmann::json& data) {
     if (data.contains("Background")) {
         Background = data["Background"];
     }
+    if (data.contains("FrameLimit")) {
+        FrameLimit = data["FrameLimit"];
+    }
 }
 
 nlohmann::json Settings::toJson() const {
     nlohmann::json data;
     data["ScreenResolution"] = ScreenResolution;
     data["Background"]       = Background;
+    data["FrameLimit"]       = FrameLimit;
     return data;
 }
 
@@ -8,6 +8,7 @@
 
 #pragma once
 #include <functional>
+#include <string_view>
 
 #include "graphics/Color.h"
 #include "graphics/image/Texture.h"
@@ -46,6 +47,8 @@ struct Settings {
     Resolution ScreenResolution{1024, 512};
     /// Background color
     graphics::Color Background = graphics::Color::fromDouble(0.3, 0.3, 0.3);
+    /// Frames drawn by run() for the renderers without display (0: no limit)
+    uint64_t FrameLimit = 0;
     /**
      * @brief Set from json
      * @param data The input json
@@ -62,9 +65,10 @@ struct Settings {
  * @brief Renderer's type
  */
 enum struct RendererType {
-    Null,  ///< Null renderer
-    OpenGL,///< OpenGL renderer
-    Unknown///< anythong else
+    Null,    ///< Null renderer
+    OpenGL,  ///< OpenGL renderer
+    Unknown, ///< anythong else
+    Software,///< In-memory frame buffer renderer
 };
 
 /**
@@ -164,13 +168,20 @@ public:
      */
     virtual void drawQuad(const math::geometry::Quad2<double>& quad, const graphics::Color& color) const = 0;
 
+    /**
+     * @brief Draw an image pixel to pixel
+     * @param image The image
+     * @param drawBox Drawing layout: the image's top left corner is on the layout's one, what exceeds the layout is clipped
+     */
+    virtual void drawImage(const image::Texture& image, const math::geometry::Box2& drawBox) const = 0;
+
     /**
      * @brief Draw text on the screen
      * @param text Text to draw
      * @param location Localisation on the screen
      * @param color Color of the text
      */
-    virtual void drawText(const std::string& text, const math::geometry::Vectf& location, const graphics::Color& color) const = 0;
+    virtual void drawText(std::string_view text, const math::geometry::Vectf& location, const graphics::Color& color) const = 0;
 
 protected:
     /// The settings
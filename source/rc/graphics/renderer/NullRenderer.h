@@ -88,13 +88,20 @@ public:
      */
     void drawQuad([[maybe_unused]] const math::geometry::Quad2<double>& quad, [[maybe_unused]] const graphics::Color& color) const override {}
 
+    /**
+     * @brief Draw an image pixel to pixel
+     * @param image The image
+     * @param drawBox Drawing layout: the image's top left corner is on the layout's one, what exceeds the layout is clipped
+     */
+    void drawImage([[maybe_unused]] const image::Texture& image, [[maybe_unused]] const math::geometry::Box2& drawBox) const override {}
+
     /**
      * @brief Draw text on the screen
      * @param text Text to draw
      * @param location Localisation on the screen
      * @param color Color of the text
      */
-    void drawText([[maybe_unused]] const std::string& text, [[maybe_unused]] const math::geometry::Vectf& location, [[maybe_unused]] const graphics::Color& color) const override {}
+    void drawText([[maybe_unused]] std::string_view text, [[maybe_unused]] const math::geometry::Vectf& location, [[maybe_unused]] const graphics::Color& color) const override {}
 
 private:
 };
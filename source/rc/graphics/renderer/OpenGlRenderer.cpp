@@ -7,8 +7,10 @@
  */
 
 #include "OpenGlRenderer.h"
+#include "graphics/WallSpan.h"
 #include <GL/freeglut.h>
-#include <execution>
+#include <algorithm>
+#include <cmath>
 
 namespace rc::graphics::renderer {
 
@@ -36,6 +38,8 @@ static void displayFunction() {
 }
 
 OpenGLRenderer::~OpenGLRenderer() {
+    if (imageTexture != 0)
+        glDeleteTextures(1, &imageTexture);
     globalPtr = nullptr;
 }
 
@@ -70,87 +74,186 @@ void OpenGLRenderer::setDrawingCallback(const std::function<void()>& func) {
 void OpenGLRenderer::setColor(const graphics::Color& color) {
     glColor4ub(color.red(), color.green(), color.blue(), color.alpha());
 }
-void OpenGLRenderer::pushVertex(const math::geometry::Vectf& vertex) {
-    glVertex2d(vertex[0], vertex[1]);
+
+void OpenGLRenderer::beginBatch(Primitive primitive, double size, size_t vertexCount) const {
+    const auto batchSize = primitive == Primitive::Quads ? 1.0F : static_cast<float>(size);
+    if (batches.empty() || batches.back().primitive != primitive || std::abs(batches.back().size - batchSize) > 0.0F)
+        batches.push_back({primitive, batchSize, vertices.size(), 0});
+    batches.back().count += vertexCount;
+}
+
+void OpenGLRenderer::pushVertex(double x, double y, const graphics::Color& color) const {
+    vertices.push_back({static_cast<float>(x), static_cast<float>(y), color});
+}
+
+void OpenGLRenderer::flush() const {
+    if (vertices.empty())
+        return;
+    static_assert(sizeof(graphics::Color) == 4, "Vertex colors are sent as 4 unsigned bytes");
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vertices.front().x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), &vertices.front().color);
+    for (const auto& batch : batches) {
+        switch (batch.primitive) {
+        case Primitive::Points:
+            glPointSize(batch.size);
+            glDrawArrays(GL_POINTS, static_cast<GLint>(batch.first), static_cast<GLsizei>(batch.count));
+            break;
+        case Primitive::Lines:
+            glLineWidth(batch.size);
+            glDrawArrays(GL_LINES, static_cast<GLint>(batch.first), static_cast<GLsizei>(batch.count));
+            break;
+        case Primitive::Quads:
+            glDrawArrays(GL_QUADS, static_cast<GLint>(batch.first), static_cast<GLsizei>(batch.count));
+            break;
+        }
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    // capacity is kept: no allocation once the frames are alike
+    vertices.clear();
+    batches.clear();
 }
 
 void OpenGLRenderer::drawPoint(const math::geometry::Vectf& location, double size, const graphics::Color& color) const {
     if (status != Status::Running)
         return;
-    setColor(color);
-    glPointSize(static_cast<GLfloat>(size));
-    glBegin(GL_POINTS);
-    pushVertex(location);
-    glEnd();
+    beginBatch(Primitive::Points, size, 1);
+    pushVertex(location, color);
 }
 
 void OpenGLRenderer::drawLine(const math::geometry::Line2<double>& line, double width, const graphics::Color& color) const {
     if (status != Status::Running)
         return;
-    setColor(color);
-    glLineWidth(static_cast<GLfloat>(width));
-    glBegin(GL_LINES);
-    pushVertex(line.getPoint(0));
-    pushVertex(line.getPoint(1));
-    glEnd();
+    beginBatch(Primitive::Lines, width, 2);
+    pushVertex(line.getPoint(0), color);
+    pushVertex(line.getPoint(1), color);
 }
 
-void OpenGLRenderer::drawTextureVerticalLine(double lineX, double lineY, double lineLength, const image::Texture& tex, double texX, const math::geometry::Box2& drawBox, bool shade) const {
+void OpenGLRenderer::drawTextureVerticalLine(double lineX, double lineY, double lineLength, const image::Texture& wall, double texX, const math::geometry::Box2& drawBox, bool shade) const {
     if (status != Status::Running)
         return;
+    if (wall.width() == 0 || wall.height() == 0)
+        return;
+    // distant walls read a smaller mipmap level, if any
+    const auto& tex = wall.getMipmapFor(lineLength);
+    texX *= static_cast<double>(tex.width()) / static_cast<double>(wall.width());
     // Coordinate are input in the layout's frame: conversion into Scree coordinates
     lineX += drawBox.left();
     lineY += drawBox.top();
     // check vertical is in the layout
     if (lineX < drawBox.left() || lineX > drawBox.right())
         return;
-    double textureIncrement = static_cast<double>(tex.height()) / lineLength;
-    const auto cols               = tex.getPixelColumn(static_cast<uint16_t>(texX));
-    const double beginCoord       = std::max(lineY, static_cast<double>(drawBox.top()));
-    const double endCoord         = lineY + lineLength > drawBox.bottom() ? drawBox.bottom() : lineY + lineLength;
-    const double length           = endCoord - beginCoord;
-    const double beginTex         = std::max(0.0, -lineY * textureIncrement);
-    glPointSize(static_cast<GLfloat>(1));
-    glBegin(GL_POINTS);
-    graphics::Color prevColor{};
-    bool hasColor = false;
-    for (double pixel = 0; pixel < length; ++pixel) {
-        const int32_t inc         = static_cast<int32_t>(beginTex + pixel * textureIncrement);
-        graphics::Color col = *(cols + inc);
-        if (shade)
+    // same sampling as the software renderer
+    const WallSpan span(lineY, lineLength, tex.height(), drawBox.top(), std::min(static_cast<double>(drawBox.bottom()), static_cast<double>(settingInternal.ScreenResolution[1])));
+    if (span.empty())
+        return;
+    const double left = std::floor(lineX);
+    const auto top    = static_cast<double>(span.firstRow());
+    // shaded texels are read from the shaded copy when the texture has one
+    const bool darken      = shade && !tex.hasShadedCopy();
+    const auto texColumn   = static_cast<size_t>(std::min(texX, static_cast<double>(tex.width() - 1)));
+    const Color* source    = (shade && !darken ? tex.shadedData() : tex.data()) + tex.pixelIndex(texColumn, 0);
+    const size_t texStride = tex.columnStride();
+    // one pixel wide quad per run of same color: textures are mostly magnified
+    size_t runBegin = 0;
+    graphics::Color runColor;
+    const auto pushRun = [&](size_t runEnd) {
+        beginBatch(Primitive::Quads, 1, 4);
+        pushVertex(left, top + static_cast<double>(runBegin), runColor);
+        pushVertex(left + 1, top + static_cast<double>(runBegin), runColor);
+        pushVertex(left + 1, top + static_cast<double>(runEnd), runColor);
+        pushVertex(left, top + static_cast<double>(runEnd), runColor);
+        runBegin = runEnd;
+    };
+    span.forEach([&](size_t pixel, size_t textureRow) {
+        auto col = source[textureRow * texStride];
+        if (darken)
             col.darken();
-        if (!hasColor || col != prevColor) {
-            setColor(col);
-            prevColor = col;
-            hasColor  = true;
-        }
-        glVertex2d(lineX, beginCoord + pixel);
-    }
-    glEnd();
+        if (pixel > 0 && col != runColor)
+            pushRun(pixel);
+        runColor = col;
+    });
+    pushRun(span.count());
 }
 
 void OpenGLRenderer::drawQuad(const math::geometry::Quad2<double>& quad, const graphics::Color& color) const {
     if (status != Status::Running)
         return;
-    setColor(color);
+    beginBatch(Primitive::Quads, 1, 4);
+    for (uint8_t i = 0; i < 4; ++i)
+        pushVertex(quad[i], color);
+}
+
+void OpenGLRenderer::drawImage(const image::Texture& image, const math::geometry::Box2& drawBox) const {
+    if (status != Status::Running || image.width() == 0 || image.height() == 0)
+        return;
+    // keep the drawing order: geometry pushed so far goes below the image
+    flush();
+    if (imageTexture == 0) {
+        glGenTextures(1, &imageTexture);
+        glBindTexture(GL_TEXTURE_2D, imageTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, imageTexture);
+    }
+    // uploaded as is: the OpenGL texture of a column-major image is transposed (its rows are the image's columns)
+    const bool transposed = image.getLayout() == image::Texture::Layout::ColumnMajor;
+    const std::array<size_t, 2> size{transposed ? image.height() : image.width(), transposed ? image.width() : image.height()};
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (size != imageTextureSize) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<GLsizei>(size[0]), static_cast<GLsizei>(size[1]), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+        imageTextureSize = size;
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(size[0]), static_cast<GLsizei>(size[1]), GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+    }
+    // clipped to the layout
+    const double width  = std::min(static_cast<double>(image.width()), static_cast<double>(drawBox.width()));
+    const double height = std::min(static_cast<double>(image.height()), static_cast<double>(drawBox.height()));
+    const double texX   = width / static_cast<double>(image.width());
+    const double texY   = height / static_cast<double>(image.height());
+    const auto left     = static_cast<double>(drawBox.left());
+    const auto top      = static_cast<double>(drawBox.top());
+    glEnable(GL_TEXTURE_2D);
+    setColor({255, 255, 255});
     glBegin(GL_QUADS);
-    pushVertex(quad[0]);
-    pushVertex(quad[1]);
-    pushVertex(quad[2]);
-    pushVertex(quad[3]);
+    const auto texCoord = [transposed](double x, double y) {
+        if (transposed)
+            glTexCoord2d(y, x);
+        else
+            glTexCoord2d(x, y);
+    };
+    texCoord(0, 0);
+    glVertex2d(left, top);
+    texCoord(texX, 0);
+    glVertex2d(left + width, top);
+    texCoord(texX, texY);
+    glVertex2d(left + width, top + height);
+    texCoord(0, texY);
+    glVertex2d(left, top + height);
     glEnd();
+    glDisable(GL_TEXTURE_2D);
 }
 
-void OpenGLRenderer::drawText(const std::string& text, const math::geometry::Vectf& location, const graphics::Color& color) const {
+void OpenGLRenderer::drawText(std::string_view text, const math::geometry::Vectf& location, const graphics::Color& color) const {
+    // keep the drawing order: geometry pushed so far goes below the text
+    flush();
     setColor(color);
     glRasterPos2d(location[0], location[1]);
-    glutBitmapString(GLUT_BITMAP_HELVETICA_18, reinterpret_cast<const unsigned char*>(text.c_str()));
+    // not null terminated: no glutBitmapString
+    for (const char c : text)
+        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, c);
 }
 
 void OpenGLRenderer::display_cb() const {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     if (mainDraw)
         mainDraw();
+    flush();
     glutSwapBuffers();
 }
 
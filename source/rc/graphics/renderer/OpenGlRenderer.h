@@ -8,6 +8,8 @@
 
 #pragma once
 #include "BaseRenderer.h"
+#include <array>
+#include <vector>
 
 namespace rc::graphics::renderer {
 
@@ -23,6 +25,11 @@ void init();
 
 /**
  * @brief Class OpenGLRenderer
+ *
+ * Drawing functions do not call OpenGL: they append vertices to a command buffer,
+ * consecutive primitives of the same kind being merged in one batch. The buffer is
+ * submitted with vertex arrays, one glDrawArrays per batch, at the end of the frame
+ * or before a text is drawn (texts are rasterized immediately by GLUT).
  */
 class OpenGLRenderer : public BaseRenderer {
 public:
@@ -96,13 +103,20 @@ public:
      */
     void drawQuad(const math::geometry::Quad2<double>& quad, const graphics::Color& color) const override;
 
+    /**
+     * @brief Draw an image pixel to pixel
+     * @param image The image
+     * @param drawBox Drawing layout: the image's top left corner is on the layout's one, what exceeds the layout is clipped
+     */
+    void drawImage(const image::Texture& image, const math::geometry::Box2& drawBox) const override;
+
     /**
      * @brief Draw text on the screen
      * @param text Text to draw
      * @param location Localisation on the screen
      * @param color Color of the text
      */
-    void drawText(const std::string& text, const math::geometry::Vectf& location, const graphics::Color& color) const override;
+    void drawText(std::string_view text, const math::geometry::Vectf& location, const graphics::Color& color) const override;
 
     /**
      * @brief Display call back
@@ -114,7 +128,65 @@ private:
 
     static void setColor(const graphics::Color& color);
 
-    static void pushVertex(const math::geometry::Vectf& vertex);
+    /**
+     * @brief Submit the command buffer to OpenGL and clear it
+     */
+    void flush() const;
+
+    /**
+     * @brief Kind of primitive of a batch
+     */
+    enum struct Primitive {
+        Points,///< Square points
+        Lines, ///< Segments, 2 vertices each
+        Quads  ///< Convex quads, 4 vertices each
+    };
+    /**
+     * @brief Vertex of the command buffer, laid out for glVertexPointer/glColorPointer
+     */
+    struct Vertex {
+        float x = 0;          ///< Screen X
+        float y = 0;          ///< Screen Y
+        graphics::Color color;///< Vertex color
+    };
+    /**
+     * @brief Consecutive vertices drawn by one draw call
+     */
+    struct Batch {
+        Primitive primitive = Primitive::Points;///< Kind of primitive
+        float size          = 1;                ///< Point size or line width
+        size_t first        = 0;                ///< First vertex
+        size_t count        = 0;                ///< Amount of vertices
+    };
+    /**
+     * @brief Start a new batch unless the last one has the same settings
+     * @param primitive Kind of primitive
+     * @param size Point size or line width (ignored for quads)
+     * @param vertexCount Amount of vertices about to be pushed
+     */
+    void beginBatch(Primitive primitive, double size, size_t vertexCount) const;
+    /**
+     * @brief Push a vertex in the last batch
+     * @param x Screen X
+     * @param y Screen Y
+     * @param color Vertex color
+     */
+    void pushVertex(double x, double y, const graphics::Color& color) const;
+    /**
+     * @brief Push a vertex in the last batch
+     * @param vertex Screen position
+     * @param color Vertex color
+     */
+    void pushVertex(const math::geometry::Vectf& vertex, const graphics::Color& color) const { pushVertex(vertex[0], vertex[1], color); }
+
+    /// Vertices of the frame (drawing functions are const in the renderer API)
+    mutable std::vector<Vertex> vertices;
+    /// Batches of the frame
+    mutable std::vector<Batch> batches;
+    /// OpenGL texture receiving the images (0 until the first image)
+    mutable uint32_t imageTexture = 0;
+    /// Size of the OpenGL texture (transposed image size)
+    mutable std::array<size_t, 2> imageTextureSize{0, 0};
 };
 
 }// namespace rc::core::renderer
@@ -0,0 +1,165 @@
+/**
+ * @file SoftwareRenderer.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "SoftwareRenderer.h"
+#include "graphics/Rasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace rc::graphics::renderer {
+
+void SoftwareRenderer::Init() {
+    frame.resize(static_cast<size_t>(std::max(settingInternal.ScreenResolution[0], 0)),
+                 static_cast<size_t>(std::max(settingInternal.ScreenResolution[1], 0)),
+                 settingInternal.Background);
+    frameCount = 0;
+    status     = Status::Ready;
+}
+
+void SoftwareRenderer::run() {
+    start();
+    while (status == Status::Running && (settingInternal.FrameLimit == 0 || frameCount < settingInternal.FrameLimit))
+        renderFrame();
+}
+
+void SoftwareRenderer::start() {
+    status = Status::Running;
+}
+
+void SoftwareRenderer::renderFrame() {
+    frame.fill(settingInternal.Background);
+    if (mainDraw)
+        mainDraw();
+    ++frameCount;
+}
+
+void SoftwareRenderer::saveFrame(const core::fs::DataFile& file) const {
+    frame.saveToFile(file);
+}
+
+void SoftwareRenderer::setPixel(int32_t x, int32_t y, const graphics::Color& color) const {
+    if (x < 0 || y < 0 || static_cast<size_t>(x) >= frame.width() || static_cast<size_t>(y) >= frame.height())
+        return;
+    *(frame.getPixelColumn(static_cast<uint16_t>(x)) + y) = color;
+}
+
+void SoftwareRenderer::fillSpan(int32_t row, int32_t xBegin, int32_t xEnd, const graphics::Color& color) const {
+    if (row < 0 || static_cast<size_t>(row) >= frame.height())
+        return;
+    xBegin = std::max(xBegin, 0);
+    xEnd   = std::min(xEnd, static_cast<int32_t>(frame.width()) - 1);
+    for (int32_t x = xBegin; x <= xEnd; ++x)
+        *(frame.getPixelColumn(static_cast<uint16_t>(x)) + row) = color;
+}
+
+void SoftwareRenderer::drawPoint(const math::geometry::Vectf& location, double size, const graphics::Color& color) const {
+    if (status != Status::Running)
+        return;
+    // same as OpenGL: a square point centered on the location
+    const double half = std::max(size, 1.0) / 2.0;
+    const auto xBegin = static_cast<int32_t>(std::floor(location[0] - half + 0.5));
+    const auto xEnd   = static_cast<int32_t>(std::floor(location[0] + half - 0.5));
+    const auto yBegin = static_cast<int32_t>(std::floor(location[1] - half + 0.5));
+    const auto yEnd   = static_cast<int32_t>(std::floor(location[1] + half - 0.5));
+    for (int32_t y = yBegin; y <= yEnd; ++y)
+        fillSpan(y, xBegin, xEnd, color);
+}
+
+void SoftwareRenderer::drawLine(const math::geometry::Line2<double>& line, double width, const graphics::Color& color) const {
+    if (status != Status::Running)
+        return;
+    const auto& p1        = line.getPoint(0);
+    const auto& p2        = line.getPoint(1);
+    const double dx       = p2[0] - p1[0];
+    const double dy       = p2[1] - p1[1];
+    const auto steps      = static_cast<int32_t>(std::ceil(std::max(std::abs(dx), std::abs(dy))));
+    const auto thickness  = std::max(static_cast<int32_t>(width), 1);
+    const int32_t before  = (thickness - 1) / 2;
+    const bool xMajor     = std::abs(dx) >= std::abs(dy);
+    const double stepX    = steps == 0 ? 0.0 : dx / steps;
+    const double stepY    = steps == 0 ? 0.0 : dy / steps;
+    for (int32_t i = 0; i <= steps; ++i) {
+        const auto x = static_cast<int32_t>(std::floor(p1[0] + i * stepX));
+        const auto y = static_cast<int32_t>(std::floor(p1[1] + i * stepY));
+        // line width is spread along the minor axis
+        for (int32_t w = -before; w < thickness - before; ++w) {
+            if (xMajor)
+                setPixel(x, y + w, color);
+            else
+                setPixel(x + w, y, color);
+        }
+    }
+}
+
+void SoftwareRenderer::drawTextureVerticalLine(double lineX, double lineY, double lineLength, const image::Texture& tex, double texX, const math::geometry::Box2& drawBox, bool shade) const {
+    if (status != Status::Running)
+        return;
+    // Coordinate are input in the layout's frame: conversion into Scree coordinates
+    lineX += drawBox.left();
+    lineY += drawBox.top();
+    // check vertical is in the layout
+    if (lineX < drawBox.left() || lineX > drawBox.right())
+        return;
+    const auto screenX = static_cast<int32_t>(lineX);
+    if (screenX < 0 || static_cast<size_t>(screenX) >= frame.width())
+        return;
+    drawWallColumn(frame, static_cast<size_t>(screenX), lineY, lineLength, tex, texX, drawBox.top(), drawBox.bottom(), shade);
+}
+
+void SoftwareRenderer::drawImage(const image::Texture& image, const math::geometry::Box2& drawBox) const {
+    if (status != Status::Running)
+        return;
+    // column by column, clipped to the box and the screen
+    const int32_t xBegin = std::max(drawBox.left(), 0);
+    const int32_t xEnd   = std::min({drawBox.left() + static_cast<int32_t>(image.width()), drawBox.right(), static_cast<int32_t>(frame.width())});
+    const int32_t yBegin = std::max(drawBox.top(), 0);
+    const int32_t yEnd   = std::min({drawBox.top() + static_cast<int32_t>(image.height()), drawBox.bottom(), static_cast<int32_t>(frame.height())});
+    if (yEnd <= yBegin)
+        return;
+    const size_t stride = image.columnStride();
+    for (int32_t x = xBegin; x < xEnd; ++x) {
+        const Color* source = image.data() + image.pixelIndex(static_cast<size_t>(x - drawBox.left()), static_cast<size_t>(yBegin - drawBox.top()));
+        auto dest           = frame.getPixelColumn(static_cast<uint16_t>(x)) + yBegin;
+        for (int32_t y = yBegin; y < yEnd; ++y, ++dest, source += stride)
+            *dest = *source;
+    }
+}
+
+void SoftwareRenderer::drawQuad(const math::geometry::Quad2<double>& quad, const graphics::Color& color) const {
+    if (status != Status::Running)
+        return;
+    // scanline fill of a convex quad, sampling pixel centers
+    double yMin = quad[0][1];
+    double yMax = quad[0][1];
+    for (uint8_t i = 1; i < 4; ++i) {
+        yMin = std::min(yMin, quad[i][1]);
+        yMax = std::max(yMax, quad[i][1]);
+    }
+    const auto rowBegin = std::max(static_cast<int32_t>(std::ceil(yMin - 0.5)), 0);
+    const auto rowEnd   = std::min(static_cast<int32_t>(std::ceil(yMax - 0.5)), static_cast<int32_t>(frame.height()));
+    for (int32_t row = rowBegin; row < rowEnd; ++row) {
+        const double yc = row + 0.5;
+        double xMin     = std::numeric_limits<double>::max();
+        double xMax     = std::numeric_limits<double>::lowest();
+        for (uint8_t i = 0; i < 4; ++i) {
+            const auto& pa = quad[i];
+            const auto& pb = quad[static_cast<uint8_t>((i + 1) % 4)];
+            if ((pa[1] <= yc && yc < pb[1]) || (pb[1] <= yc && yc < pa[1])) {
+                const double x = pa[0] + (yc - pa[1]) * (pb[0] - pa[0]) / (pb[1] - pa[1]);
+                xMin           = std::min(xMin, x);
+                xMax           = std::max(xMax, x);
+            }
+        }
+        if (xMax < xMin)
+            continue;
+        fillSpan(row, static_cast<int32_t>(std::ceil(xMin - 0.5)), static_cast<int32_t>(std::ceil(xMax - 0.5)) - 1, color);
+    }
+}
+
+}// namespace rc::graphics::renderer
@@ -0,0 +1,163 @@
+/**
+ * @file SoftwareRenderer.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "BaseRenderer.h"
+
+namespace rc::graphics::renderer {
+
+/**
+ * @brief Class SoftwareRenderer
+ *
+ * Rasterize everything into an in-memory RGBA frame buffer, no display needed.
+ * The frame buffer is a texture, so it is stored column-major like every texture.
+ * run() is a headless frame loop, drawing frames until the FrameLimit of the settings
+ * (endless if 0). start() only starts the renderer: frames are then drawn one by one with
+ * renderFrame(), as tests and benchmarks do.
+ */
+class SoftwareRenderer : public BaseRenderer {
+public:
+    SoftwareRenderer(const SoftwareRenderer&)            = delete;
+    SoftwareRenderer(SoftwareRenderer&&)                 = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(SoftwareRenderer&&)      = delete;
+    /**
+     * @brief Default constructor.
+     */
+    SoftwareRenderer() = default;
+    /**
+     * @brief Destructor.
+     */
+    ~SoftwareRenderer() override = default;
+    /**
+     * @brief Initialize the renderer
+     */
+    void Init() override;
+    /**
+     * @brief Starts the renderer and draw frames until the frame limit
+     */
+    void run() override;
+    /**
+     * @brief Starts the renderer, without drawing any frame
+     */
+    void start();
+    /**
+     * @brief Force display update
+     */
+    void update() override {}
+
+    /**
+     * @brief Defines the main draw call back
+     * @param func The drawing callback
+     */
+    void setDrawingCallback(const std::function<void()>& func) override { mainDraw = func; }
+    /**
+      * @brief Gets the renderer Type
+      * @return Renderer type
+      */
+    [[nodiscard]] RendererType getType() const override { return RendererType::Software; }
+    // Drawing functions
+    /**
+     * @brief Draw a point
+     * @param location Where to draw in screen coordinate
+     * @param size Size of the point
+     * @param color Color of the point
+     */
+    void drawPoint(const math::geometry::Vectf& location, double size, const graphics::Color& color) const override;
+    /**
+     * @brief Draw a line
+     * @param line Line's data
+     * @param width Width of the line
+     * @param color Line's color
+     */
+    void drawLine(const math::geometry::Line2<double>& line, double width, const graphics::Color& color) const override;
+
+    /**
+     * @brief Draw a textured vertical line
+     * @param lineX X coordinate of the line
+     * @param lineY Y starting of the line (may be outside the layout)
+     * @param lineLength Length of the line
+     * @param tex Texture to apply
+     * @param texX X coordinate on the texture image
+     * @param drawBox Drawing layout
+     * @param dark If the color should be shaded
+     */
+    void drawTextureVerticalLine(double lineX, double lineY, double lineLength, const image::Texture& tex, double texX, const math::geometry::Box2& drawBox, bool dark = false) const override;
+    /**
+     * @brief Draw a quad
+     * @param quad Quad's data
+     * @param color Quad's color
+     */
+    void drawQuad(const math::geometry::Quad2<double>& quad, const graphics::Color& color) const override;
+
+    /**
+     * @brief Draw an image pixel to pixel
+     * @param image The image
+     * @param drawBox Drawing layout: the image's top left corner is on the layout's one, what exceeds the layout is clipped
+     */
+    void drawImage(const image::Texture& image, const math::geometry::Box2& drawBox) const override;
+
+    /**
+     * @brief Draw text on the screen
+     * @param text Text to draw
+     * @param location Localisation on the screen
+     * @param color Color of the text
+     *
+     * There is no font rasterizer: text is ignored.
+     */
+    void drawText([[maybe_unused]] std::string_view text, [[maybe_unused]] const math::geometry::Vectf& location, [[maybe_unused]] const graphics::Color& color) const override {}
+
+    /**
+     * @brief Clear the frame buffer and call the drawing callback
+     */
+    void renderFrame();
+
+    /**
+     * @brief Access to the frame buffer
+     * @return The last rendered frame
+     */
+    [[nodiscard]] const image::Texture& getFrame() const { return frame; }
+
+    /**
+     * @brief Get the amount of rendered frames
+     * @return Frame count
+     */
+    [[nodiscard]] const uint64_t& getFrameCount() const { return frameCount; }
+
+    /**
+     * @brief Save the current frame as PNG
+     * @param file The destination file
+     */
+    void saveFrame(const core::fs::DataFile& file) const;
+
+private:
+    /**
+     * @brief Fill an horizontal span of pixels, clipped to the screen
+     * @param row The pixel row
+     * @param xBegin First column
+     * @param xEnd Last column (included)
+     * @param color The color
+     */
+    void fillSpan(int32_t row, int32_t xBegin, int32_t xEnd, const graphics::Color& color) const;
+    /**
+     * @brief Set one pixel, clipped to the screen
+     * @param x Pixel column
+     * @param y Pixel row
+     * @param color The color
+     */
+    void setPixel(int32_t x, int32_t y, const graphics::Color& color) const;
+
+    /// The main drawing callback
+    std::function<void()> mainDraw;
+    /// The frame buffer (drawing functions are const in the renderer API)
+    mutable image::Texture frame;
+    /// Amount of rendered frame
+    uint64_t frameCount = 0;
+};
+
+}// namespace rc::graphics::renderer
@@ -0,0 +1,64 @@
+/**
+ * @file CellPattern.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "game/Map.h"
+
+namespace we {
+
+/**
+ * @brief Patterns the editor paints on the map
+ */
+enum struct Pattern {
+    Passable,
+    Wall1,
+    Wall1b,
+    Wall2,
+    Wall2b,
+    Wall3,
+    Wall3b,
+};
+
+/**
+ * @brief Get the cell painted by a pattern
+ * @param pattern The pattern
+ * @return The cell
+ */
+inline rc::game::mapCell patternCell(Pattern pattern) {
+    switch (pattern) {
+    case Pattern::Passable:
+        return {true, true, 0};
+    case Pattern::Wall1:
+        return {false, false, 0b10};
+    case Pattern::Wall1b:
+        return {false, false, 0b11};
+    case Pattern::Wall2:
+        return {false, false, 0b100};
+    case Pattern::Wall2b:
+        return {false, false, 0b101};
+    case Pattern::Wall3:
+        return {false, false, 0b110};
+    case Pattern::Wall3b:
+        return {false, false, 0b111};
+    }
+    return {true, true, 0};
+}
+
+/**
+ * @brief Paint a pattern on a cell of the map
+ * @param map The map
+ * @param location Cell's coordinates
+ * @param pattern The pattern
+ *
+ * The edit goes through Map::setCell, so the distance field and the occupancy follow.
+ */
+inline void paintPattern(rc::game::Map& map, const rc::game::Map::gridCoordinate& location, Pattern pattern) {
+    map.setCell(location, patternCell(pattern));
+}
+
+}// namespace we
@@ -179,44 +179,7 @@ void MainWindow::mouseReleaseEvent(QMouseEvent* /*event*/) {
         ui->tableCell->setCell(mouseCell);
     }else if (currentMode == Mode::Edit){
         ui->tableCell->setCell(mouseCell);
-        auto& cell = theMap->at({static_cast<unsigned char>(mouseCell.x()),static_cast<unsigned char>(mouseCell.y())});
-        switch (currentPattern) {
-        case Pattern::Passable:
-            cell.passable = true;
-            cell.visibility = true;
-            cell.textureId = 0;
-            break;
-        case Pattern::Wall1:
-            cell.passable = false;
-            cell.visibility = false;
-            cell.textureId = 0b10;
-            break;
-        case Pattern::Wall1b:
-            cell.passable = false;
-            cell.visibility = false;
-            cell.textureId = 0b11;
-            break;
-        case Pattern::Wall2:
-            cell.passable = false;
-            cell.visibility = false;
-            cell.textureId = 0b100;
-            break;
-        case Pattern::Wall2b:
-            cell.passable = false;
-            cell.visibility = false;
-            cell.textureId = 0b101;
-            break;
-        case Pattern::Wall3:
-            cell.passable = false;
-            cell.visibility = false;
-            cell.textureId = 0b110;
-            break;
-        case Pattern::Wall3b:
-            cell.passable = false;
-            cell.visibility = false;
-            cell.textureId = 0b111;
-            break;
-        }
+        paintPattern(*theMap, {static_cast<rc::game::Map::IndexType>(mouseCell.x()), static_cast<rc::game::Map::IndexType>(mouseCell.y())}, currentPattern);
         mapModified = true;
         ui->DrawArea->repaint();
     }
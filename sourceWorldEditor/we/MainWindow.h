@@ -7,6 +7,7 @@
  */
 
 #pragma once
+#include "CellPattern.h"
 #include "game/Map.h"
 #include <QMainWindow>
 
@@ -97,15 +98,6 @@ private:
     };
     Mode currentMode = Mode::Select;
 
-    enum struct Pattern {
-        Passable,
-        Wall1,
-        Wall1b,
-        Wall2,
-        Wall2b,
-        Wall3,
-        Wall3b,
-    };
     Pattern currentPattern = Pattern::Passable;
 
     void timedOut();
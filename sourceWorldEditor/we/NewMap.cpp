@@ -24,7 +24,7 @@ NewMap::~NewMap() {
 }
 
 const NewMap::Infos NewMap::getInfos() const {
-    return {ui->EditName->text(), static_cast<uint8_t>(ui->EditWidth->value()),static_cast<uint8_t>(ui->EditHeight->value()), static_cast<uint8_t>(ui->EditCellSize->value())};
+    return {ui->EditName->text(), static_cast<rc::game::Map::IndexType>(ui->EditWidth->value()),static_cast<rc::game::Map::IndexType>(ui->EditHeight->value()), static_cast<rc::game::Map::CellSizeType>(ui->EditCellSize->value())};
 }
 
 void NewMap::setInfos(const NewMap::Infos& infos) {
@@ -7,6 +7,7 @@
  */
 
 #pragma once
+#include "game/Map.h"
 #include <QDialog>
 
 namespace Ui {
@@ -40,9 +41,9 @@ public:
      */
     struct Infos {
         QString name; ///< Map name
-        uint8_t width; ///< Map width
-        uint8_t height; ///< Map height
-        uint8_t cellSize; ///< Map Cell size
+        rc::game::Map::IndexType width; ///< Map width
+        rc::game::Map::IndexType height; ///< Map height
+        rc::game::Map::CellSizeType cellSize; ///< Map Cell size
     };
 
     /**
@@ -65,18 +65,19 @@ void RenderArea::paintEvent(QPaintEvent*) {
         return;
     const QPoint Start{static_cast<int>((width() - increment * static_cast<int32_t>(mapLink->width())) / 2), static_cast<int>((height() - increment * static_cast<int32_t>(mapLink->height())) / 2)};
     QRect CellRect{Start.x(), Start.y(), increment, increment};
-    for (const auto& line : mapLink->getMapData()) {
-        for (const auto& cell : line) {
-            if (cell.passable) {
-                painter.setBrush(QBrush(QColor(10, 10, 10)));
-            } else {
-                auto& col = cell.getMapColor();
-                painter.setBrush(QBrush(QColor(col.red(), col.green(), col.blue())));
-            }
-            painter.drawRect(CellRect);
-            CellRect.moveTo(CellRect.right() + 1, CellRect.top());
+    const auto& cells = mapLink->getMapData();
+    for (size_t idx = 0; idx < cells.size(); ++idx) {
+        const auto& cell = cells[idx];
+        if (cell.passable) {
+            painter.setBrush(QBrush(QColor(10, 10, 10)));
+        } else {
+            auto& col = cell.getMapColor();
+            painter.setBrush(QBrush(QColor(col.red(), col.green(), col.blue())));
         }
-        CellRect.moveTo(Start.x(), CellRect.bottom() + 1);
+        painter.drawRect(CellRect);
+        CellRect.moveTo(CellRect.right() + 1, CellRect.top());
+        if ((idx + 1) % mapLink->stride() == 0)
+            CellRect.moveTo(Start.x(), CellRect.bottom() + 1);
     }
     // Player start
     const auto [pPos,pDir] = mapLink->getPlayerStart();
@@ -2,6 +2,7 @@
 #include "core/Engine.h"
 #include "testHelper.h"
 #include "core/fs/DataFile.h"
+#include "graphics/renderer/SoftwareRenderer.h"
 
 using Engine = rc::core::Engine;
 
@@ -47,3 +48,51 @@ TEST(Engine, base2) {
     rc::core::fs::DataFile fSets("settings_temp.json");
     fSets.remove();
 }
+
+TEST(Engine, pagedLevel) {
+    auto& engine = Engine::get();
+    auto sets    = engine.getSettings();
+    sets.rendererType                      = rc::graphics::renderer::RendererType::Software;
+    sets.inputType                         = rc::core::input::InputType::Null;
+    sets.rendererSettings.ScreenResolution = {320, 200};
+    sets.rendererSettings.FrameLimit       = 1;
+    sets.layout3D                          = {{0, 0}, {320, 200}};
+    sets.drawMap                           = false;
+    sets.pagedLevelCells                   = 0;
+    rc::game::Map map;
+    map.loadFromData("E1L1");
+    map.saveToData("pagedTest", rc::game::Map::FileFormat::Binary);
+    engine.setSettings(sets);
+    engine.init();
+    engine.mapLoad("pagedTest");
+    EXPECT_FALSE(engine.isLevelPaged());
+    engine.run();
+    auto* renderer = dynamic_cast<rc::graphics::renderer::SoftwareRenderer*>(engine.getRenderer());
+    ASSERT_NE(renderer, nullptr);
+    const auto expected = renderer->getFrame();
+    // a wall in front of the player, the sky above
+    EXPECT_NE(expected.getPixel(160, 100), expected.getPixel(160, 0));
+    // same level, played by chunks: same frame
+    sets.pagedLevelCells = 1000;
+    engine.setSettings(sets);
+    engine.mapLoad("pagedTest");
+    EXPECT_TRUE(engine.isLevelPaged());
+    engine.run();
+    renderer = dynamic_cast<rc::graphics::renderer::SoftwareRenderer*>(engine.getRenderer());
+    ASSERT_NE(renderer, nullptr);
+    EXPECT_EQ(renderer->getFrameCount(), 1);
+    size_t diff = 0;
+    for (uint16_t x = 0; x < expected.width(); ++x)
+        for (uint16_t y = 0; y < expected.height(); ++y)
+            diff += renderer->getFrame().getPixel(x, y) != expected.getPixel(x, y) ? 1 : 0;
+    EXPECT_EQ(diff, 0);
+    // the level edited and saved as json: its stale binary file is not played
+    map.saveToData("pagedTest");
+    const rc::core::fs::DataFile binary("maps/pagedTest.rcmap");
+    const rc::core::fs::DataFile json("maps/pagedTest.map");
+    std::filesystem::last_write_time(binary.getFullPath(), std::filesystem::last_write_time(json.getFullPath()) - std::chrono::seconds(10));
+    engine.mapLoad("pagedTest");
+    EXPECT_FALSE(engine.isLevelPaged());
+    binary.remove();
+    json.remove();
+}
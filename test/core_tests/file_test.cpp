@@ -1,5 +1,6 @@
 
 #include "core/fs/DataFile.h"
+#include "core/fs/MappedFile.h"
 #include "testHelper.h"
 
 TEST(DataFile, base) {
@@ -18,3 +19,22 @@ TEST(DataFile, base) {
     fileVoid.setPath(fileTest.getFullPath());
     EXPECT_TRUE(fileVoid.getPath() == fileTest.getPath());
 }
+
+TEST(MappedFile, base) {
+    rc::core::fs::DataFile fileTest("bob.bin");
+    EXPECT_FALSE(rc::core::fs::MappedFile(fileTest.getFullPath()).isOpen());
+    const std::vector<uint8_t> bytes{1, 2, 3, 255};
+    fileTest.writeBinary(bytes);
+    rc::core::fs::MappedFile mapped(fileTest.getFullPath());
+    ASSERT_TRUE(mapped.isOpen());
+    EXPECT_EQ(mapped.size(), 4);
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), mapped.data().begin(), mapped.data().end()));
+    rc::core::fs::MappedFile moved(std::move(mapped));
+    EXPECT_TRUE(moved.isOpen());
+    EXPECT_EQ(moved.data()[3], 255);
+    fileTest.remove();
+    // an empty file has nothing to map
+    fileTest.touch();
+    EXPECT_FALSE(rc::core::fs::MappedFile(fileTest.getFullPath()).isOpen());
+    fileTest.remove();
+}
@@ -0,0 +1,70 @@
+
+#include "core/tool/FrameArena.h"
+#include "core/tool/Tracker.h"
+#include "testHelper.h"
+#include <vector>
+
+using FrameArena = rc::core::tool::FrameArena;
+using Tracker    = rc::core::tool::Tracker;
+
+TEST(FrameArena, base) {
+    FrameArena arena{1024};
+    EXPECT_EQ(arena.capacity(), 1024);
+    EXPECT_EQ(arena.used(), 0);
+    void* first  = arena.allocate(10, 1);
+    void* second = arena.allocate(8, 8);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 8, 0);
+    EXPECT_EQ(static_cast<std::byte*>(second) - static_cast<std::byte*>(first), 16);
+    EXPECT_EQ(arena.used(), 24);
+    void* aligned = arena.allocate(4, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+    arena.deallocate(aligned, 4, 64);
+    EXPECT_EQ(arena.overflowCount(), 0);
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0);
+    EXPECT_GE(arena.highWater(), 28);
+    // memory is reused
+    EXPECT_EQ(arena.allocate(10, 1), first);
+    EXPECT_TRUE(arena.is_equal(arena));
+    FrameArena other;
+    EXPECT_FALSE(arena.is_equal(other));
+}
+
+TEST(FrameArena, overflow) {
+    FrameArena arena;
+    EXPECT_EQ(arena.capacity(), 0);
+    {
+        std::pmr::vector<double> values(100, &arena);
+        values.back() = 3.0;
+        void* aligned = arena.allocate(16, 32);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 32, 0);
+    }
+    EXPECT_EQ(arena.overflowCount(), 2);
+    arena.reset();
+    // grown to the high water mark
+    EXPECT_GE(arena.capacity(), 100 * sizeof(double) + 16);
+    for (int frame = 0; frame < 3; ++frame) {
+        std::pmr::vector<double> values(100, &arena);
+        arena.allocate(16, 32);
+        arena.reset();
+    }
+    EXPECT_EQ(arena.overflowCount(), 2);
+}
+
+TEST(FrameArena, noHeap) {
+    if (!Tracker::enabled)
+        GTEST_SKIP() << "Memory tracker compiled out";
+    FrameArena arena{4096};
+    auto& tracker = Tracker::get();
+    tracker.checkState();
+    for (int frame = 0; frame < 10; ++frame) {
+        {
+            std::pmr::vector<int> values(&arena);
+            for (int i = 0; i < 100; ++i)
+                values.push_back(i);
+            std::pmr::string text{"a text too long for the small string buffer", &arena};
+        }
+        arena.reset();
+    }
+    EXPECT_EQ(tracker.checkState().m_allocationCalls, 0);
+}
@@ -0,0 +1,95 @@
+#include "core/tool/Tracker.h"
+#include "testHelper.h"
+#include <memory>
+#include <thread>
+
+using Tracker = rc::core::tool::Tracker;
+
+TEST(Tracker, threads) {
+    if (!Tracker::enabled)
+        GTEST_SKIP() << "Memory tracker compiled out";
+    constexpr size_t threadCount = 8;
+    constexpr size_t loops       = 10000;
+    auto& tracker                = Tracker::get();
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    tracker.checkState();
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&tracker] {
+            for (size_t i = 0; i < loops; ++i)
+                tracker.allocate(16);
+            for (size_t i = 0; i < loops; ++i)
+                tracker.deallocate(16);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    const auto res = tracker.checkState();
+    // thread creation may allocate too
+    EXPECT_GE(res.m_allocationCalls, threadCount * loops);
+    EXPECT_LE(res.m_allocationCalls, threadCount * loops + 100);
+    EXPECT_GE(res.m_deallocationCalls, threadCount * loops);
+    EXPECT_GE(res.m_memoryPeek, 16 * loops);
+    EXPECT_LE(res.m_memoryPeek, 16 * loops * threadCount + 10000);
+    // counters restart after check
+    EXPECT_EQ(tracker.checkState().m_allocationCalls, 0);
+    const auto& globals = tracker.globals();
+    EXPECT_GE(globals.m_allocationCalls, threadCount * loops);
+    EXPECT_GE(globals.m_memoryPeek, res.m_memoryPeek);
+}
+
+TEST(Tracker, frameState) {
+    if (!Tracker::enabled)
+        GTEST_SKIP() << "Memory tracker compiled out";
+    auto& tracker = Tracker::get();
+    tracker.checkState();
+    {
+        auto first  = std::make_unique<char[]>(1000);
+        auto second = std::make_unique<char[]>(500);
+        first.reset();
+        auto third = std::make_unique<char[]>(300);
+    }
+    const auto res = tracker.checkState();
+    EXPECT_EQ(res.m_allocationCalls, 3);
+    EXPECT_EQ(res.m_allocatedBytes, 1800);
+    // the compiler may release the first block after the third allocation
+    EXPECT_GE(res.m_memoryPeek, 1500);
+    EXPECT_LE(res.m_memoryPeek, 1800);
+}
+
+/**
+ * @brief Allocate from a single call site
+ * @param size Allocation size
+ * @return The allocation
+ */
+static std::unique_ptr<char[]> allocateFromSite(size_t size) {
+    return std::make_unique<char[]>(size);
+}
+
+TEST(Tracker, sites) {
+    if (!Tracker::enabled)
+        GTEST_SKIP() << "Memory tracker compiled out";
+    auto& tracker = Tracker::get();
+    tracker.resetSites();
+    EXPECT_FALSE(tracker.isCapturingSites());
+    tracker.captureSites(true);
+    EXPECT_TRUE(tracker.isCapturingSites());
+    for (uint16_t i = 0; i < 10; ++i) {
+        [[maybe_unused]] auto big = allocateFromSite(400);
+        [[maybe_unused]] auto small = allocateFromSite(20);
+    }
+    tracker.captureSites(false);
+    const auto sites = tracker.topSites(2);
+    ASSERT_EQ(sites.size(), 2);
+    EXPECT_EQ(sites[0].m_sizeClass, 512);
+    EXPECT_EQ(sites[0].m_calls, 10);
+    EXPECT_EQ(sites[0].m_bytes, 4000);
+    EXPECT_EQ(sites[1].m_sizeClass, 32);
+    EXPECT_EQ(sites[1].m_calls, 10);
+    EXPECT_EQ(tracker.droppedSites(), 0);
+    // nothing recorded once stopped
+    [[maybe_unused]] auto other = allocateFromSite(4000);
+    EXPECT_EQ(tracker.topSites(10).size(), sites.size());
+    tracker.resetSites();
+    EXPECT_TRUE(tracker.topSites(10).empty());
+}
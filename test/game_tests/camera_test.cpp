@@ -0,0 +1,50 @@
+
+#include "game/Camera.h"
+#include "testHelper.h"
+#include <vector>
+
+using Camera = rc::game::Camera;
+using Unit   = rc::math::geometry::Angle::Unit;
+
+TEST(Camera, base) {
+    Camera camera;
+    EXPECT_NEAR(camera.getFov().getUnit(Unit::Degree), 60, 0.00001);
+    EXPECT_NEAR(camera.getDirection()[0], 1, 0.00001);
+    EXPECT_NEAR(camera.getDirection()[1], 0, 0.00001);
+    EXPECT_NEAR(camera.getPlane()[0], 0, 0.00001);
+    EXPECT_NEAR(camera.getPlane()[1], 0.57735, 0.00001);
+    camera.setDirection({0, 5});
+    EXPECT_NEAR(camera.getDirection()[1], 1, 0.00001);
+    EXPECT_NEAR(camera.getPlane().dot(camera.getDirection()), 0, 0.00001);
+    EXPECT_NEAR(camera.getPlane()[0], -0.57735, 0.00001);
+    camera.setFov({90, Unit::Degree});
+    EXPECT_NEAR(camera.getPlane().length(), 1, 0.00001);
+    EXPECT_NEAR(camera.getFocalLength(860), 430, 0.00001);
+    camera.setFov({400, Unit::Degree});
+    EXPECT_NEAR(camera.getFov().getUnit(Unit::Degree), Camera::maxFov, 0.00001);
+    camera.setFov({0, Unit::Degree});
+    EXPECT_NEAR(camera.getFov().getUnit(Unit::Degree), Camera::minFov, 0.00001);
+    Camera camera2{{90, Unit::Degree}};
+    EXPECT_NEAR(camera2.getPlane()[1], 1, 0.00001);
+}
+
+TEST(Camera, rays) {
+    Camera camera{{90, Unit::Degree}};
+    camera.setDirection({0, -1});
+    std::vector<Camera::DirectionType> rays(5);
+    camera.buildRays(rays);
+    // screen edges at half the field of view, on the same side as the former angular stepping
+    const auto left = Camera::DirectionType{0, -1}.rotated({-45, Unit::Degree});
+    EXPECT_NEAR(rays.front().getAngle().get(), left.getAngle().get(), 0.00001);
+    EXPECT_NEAR(rays[2][0], 0, 0.00001);
+    EXPECT_NEAR(rays[2][1], -1, 0.00001);
+    // evenly spaced on the camera plane, all at depth 1
+    for (const auto& ray : rays)
+        EXPECT_NEAR(camera.getDepth(ray), 1, 0.00001);
+    for (size_t col = 1; col < rays.size(); ++col)
+        EXPECT_NEAR((rays[col] - rays[col - 1]).length(), 0.5, 0.00001);
+    camera.buildRays(std::span{rays}.first(1));
+    EXPECT_NEAR(rays.front()[0], 0, 0.00001);
+    EXPECT_NEAR(rays.front()[1], -1, 0.00001);
+    camera.buildRays({});
+}
@@ -1,8 +1,13 @@
 
+#include "CellPattern.h"
 #include "core/fs/DataFile.h"
 #include "game/Map.h"
+#include "game/RayWalk.h"
+#include "rayCastReference.h"
 #include "testHelper.h"
 #include <chrono>
+#include <random>
+#include <utility>
 
 using testClock = std::chrono::steady_clock;
 using timePoint = testClock::time_point;
@@ -25,6 +30,14 @@ static Map ConstructBaseMap() {
     return map;
 }
 
+static Map::StorageType Flatten(const Map::DataType& data) {
+    Map::StorageType result;
+    for (const auto& line : data)
+        for (const auto& cell : line)
+            result.push_back(cell);
+    return result;
+}
+
 TEST(Map, base) {
     Map map;
     EXPECT_FALSE(map.isValid());
@@ -39,7 +52,7 @@ TEST(Map, base) {
     Map::DataType data = {{{false, false, 1}, {true, true, 0}}, {{true, true, 0}, {false, false, 1}}};
     map.setMap(data);
     EXPECT_TRUE(map.isValid());
-    EXPECT_EQ(map.getMapData(), data);
+    EXPECT_EQ(map.getMapData(), Flatten(data));
     EXPECT_EQ(map({0, 1}), (Map::BaseType{true, true, 0}));
 }
 
@@ -52,7 +65,7 @@ TEST(Map, init) {
     {
         Map::DataType data = {{{false, false, 1}, {false, false, 2}, {false, false, 3}}, {{false, false, 4}, {false, false, 5}, {false, false, 6}}, {{false, false, 7}, {false, false, 8}, {false, false, 9}}};
         Map map(data);
-        EXPECT_EQ(map.getMapData(), data);
+        EXPECT_EQ(map.getMapData(), Flatten(data));
     }
     {
         Map map(0, 0);
@@ -65,6 +78,44 @@ TEST(Map, init) {
     }
 }
 
+TEST(Map, storage) {
+    Map map(3, 2);
+    ASSERT_TRUE(map.isValid());
+    EXPECT_EQ(map.stride(), 3);
+    EXPECT_EQ(map.getMapData().size(), 6);
+    map.setCell({2, 1}, {true, true, 5});
+    EXPECT_EQ(map.getMapData()[5], (Map::BaseType{true, true, 5}));
+    map.setCell({0, 1}, {true, false, 7});
+    EXPECT_EQ(map.getMapData()[3], (Map::BaseType{true, false, 7}));
+}
+
+TEST(Map, cellPlanes) {
+    Map::StorageType cells;
+    cells.assign(100, {false, true, 3});
+    EXPECT_EQ(cells.size(), 100);
+    EXPECT_EQ(cells[70], (Map::BaseType{false, true, 3}));
+    // one field of a cell changed through the reference
+    cells[70].passable  = true;
+    cells[70].textureId = 6;
+    cells[71].isViewed  = true;
+    EXPECT_EQ(cells[70], (Map::BaseType{true, true, 6}));
+    EXPECT_TRUE(cells.isViewed(71));
+    EXPECT_FALSE(cells.isViewed(70));
+    EXPECT_TRUE(cells.isVisible(99));
+    cells[69] = cells[70];
+    EXPECT_EQ(cells[69], (Map::BaseType{true, true, 6}));
+    // same planes built cell by cell
+    Map::StorageType built;
+    for (size_t cell = 0; cell < 100; ++cell)
+        built.push_back(cells[cell]);
+    EXPECT_EQ(built, cells);
+    Map::StorageType generated;
+    generated.generate(100, [&built](size_t cell) { return std::as_const(built)[cell]; });
+    EXPECT_EQ(generated, cells);
+    // three bits and one byte per cell
+    EXPECT_EQ(cells.getMemoryUsage(), 3 * 2 * sizeof(uint64_t) + 100);
+}
+
 TEST(Map, CheckInside) {
     Map map(10, 10);
     ASSERT_TRUE(map.isValid());
@@ -84,8 +135,30 @@ TEST(Map, whichCell) {
     EXPECT_EQ(loc[0], 2);
     EXPECT_EQ(loc[1], 3);
     loc = map.whichCell({-1, -1});
-    EXPECT_EQ(loc[0], 255);
-    EXPECT_EQ(loc[1], 255);
+    EXPECT_EQ(loc[0], Map::maxSize);
+    EXPECT_EQ(loc[1], Map::maxSize);
+    EXPECT_FALSE(map.isIn(loc));
+    loc = map.whichCell({1e12, 150});
+    EXPECT_EQ(loc[0], Map::maxSize);
+    EXPECT_EQ(loc[1], 2);
+}
+
+TEST(Map, largeMap) {
+    Map map(300, 300, 256);
+    ASSERT_TRUE(map.isValid());
+    EXPECT_EQ(map.getCellSize(), 256);
+    EXPECT_EQ(map.fullWidth(), 76800);
+    for (Map::IndexType i = 1; i < 299; ++i)
+        map.setCell({i, 150}, {true, true, 0});
+    const auto loc = map.whichCell({280.5 * 256, 150.5 * 256});
+    EXPECT_EQ(loc[0], 280);
+    EXPECT_EQ(loc[1], 150);
+    EXPECT_TRUE(map.isInVisible(loc));
+    // ray along the corridor reaches the far wall without wrapping
+    const auto cast = map.castRay({1.5 * 256, 150.5 * 256}, {1, 0});
+    EXPECT_TRUE(cast.hitVertical);
+    EXPECT_NEAR(cast.wallPoint[0], 299 * 256, 0.01);
+    EXPECT_EQ(map.whichCell(cast.wallPoint)[0], 299);
 }
 
 TEST(Map, castRay) {
@@ -177,6 +250,208 @@ TEST(Map, castRay) {
     EXPECT_LE(micros, maxDuration);
 }
 
+TEST(Map, castRayTwoPassEquivalence) {
+    using Unit = rc::math::geometry::Angle::Unit;
+    Map map;
+    map.loadFromData("E1L1");
+    ASSERT_TRUE(map.isValid());
+    const double cube = map.getCellSize();
+    uint32_t count    = 0;
+    for (Map::IndexType i = 0; i < map.width(); ++i) {
+        for (Map::IndexType j = 0; j < map.height(); ++j) {
+            if (!map.isInVisible(Map::gridCoordinate{i, j}))
+                continue;
+            // off-center start so that rays do not run along grid lines
+            const Map::worldCoordinates position{(i + 0.37) * cube, (j + 0.61) * cube};
+            Map::worldCoordinates ray{1, 0};
+            ray.rotate({1.3, Unit::Degree});
+            for (uint16_t r = 0; r < 72; ++r, ++count) {
+                const auto cast      = map.castRay(position, ray);
+                const auto reference = rc::test::castRayTwoPass(map, position, ray);
+                ASSERT_NEAR(cast.distance, reference.distance, 0.0001);
+                ASSERT_NEAR(cast.wallPoint[0], reference.wallPoint[0], 0.0001);
+                ASSERT_NEAR(cast.wallPoint[1], reference.wallPoint[1], 0.0001);
+                ASSERT_EQ(cast.hitVertical, reference.hitVertical);
+                ASSERT_NEAR(cast.hitXRatio, reference.hitXRatio, 0.0001);
+                ray.rotate({5.0, Unit::Degree});
+            }
+        }
+    }
+    EXPECT_GT(count, 0);
+}
+
+TEST(Map, castRayOutside) {
+    rc::game::mapCell voids{true, true, 0};
+    Map map{{{voids, voids, voids},
+             {voids, voids, voids},
+             {voids, voids, voids}}};
+    ASSERT_TRUE(map.isValid());
+    // without border walls the ray stops on the map border
+    const auto cast = map.castRay({96, 96}, {1, 0});
+    EXPECT_NEAR(cast.distance, 96.001, 0.0001);
+    EXPECT_NEAR(cast.wallPoint[0], 192.001, 0.0001);
+    EXPECT_TRUE(cast.hitVertical);
+    EXPECT_FALSE(map.isIn(map.whichCell(cast.wallPoint)));
+    // null direction
+    EXPECT_NEAR(map.castRay({96, 96}, {0, 0}).distance, 0, 0.0001);
+}
+
+/**
+ * @brief Fill a map with a room and random pillars
+ * @param map The map to fill, through the raw data
+ * @param seed Random seed
+ * @param spacing One cell in spacing is a pillar
+ */
+static void randomArena(Map& map, uint32_t seed, int spacing) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<int> pillar{1, spacing};
+    const size_t columns = map.stride();
+    const size_t lines   = map.getMapData().size() / columns;
+    for (size_t i = 1; i < columns - 1; ++i)
+        for (size_t j = 1; j < lines - 1; ++j)
+            map.getMapData()[j * columns + i] = pillar(gen) == 1 ? rc::game::mapCell{false, false, 2} : rc::game::mapCell{true, true, 0};
+}
+
+/**
+ * @brief Check the distance field against a brute force computation
+ * @param map The map
+ */
+static void checkDistances(const Map& map) {
+    const auto columns = static_cast<int64_t>(map.stride());
+    const auto lines   = static_cast<int64_t>(map.getMapData().size()) / columns;
+    for (int64_t x = 0; x < columns; ++x) {
+        for (int64_t y = 0; y < lines; ++y) {
+            int64_t expected = std::min({x + 1, y + 1, columns - x, lines - y, static_cast<int64_t>(Map::maxDistance)});
+            for (int64_t wx = 0; wx < columns; ++wx)
+                for (int64_t wy = 0; wy < lines; ++wy)
+                    if (!map.getMapData()[static_cast<size_t>(wy * columns + wx)].visibility)
+                        expected = std::min(expected, std::max(std::abs(wx - x), std::abs(wy - y)));
+            const Map::gridCoordinate cell{static_cast<Map::IndexType>(x), static_cast<Map::IndexType>(y)};
+            ASSERT_EQ(map.getDistance(cell), expected) << x << " " << y;
+        }
+    }
+}
+
+TEST(Map, distanceField) {
+    Map map(90, 40);
+    randomArena(map, 7, 25);
+    map.updateDistanceField();
+    checkDistances(map);
+    map.setCell({45, 20}, {false, false, 2});
+    map.setCell({3, 3}, {false, false, 2});
+    map.setCell({88, 38}, {false, false, 2});
+    checkDistances(map);
+    map.setCell({45, 20}, {true, true, 0});
+    map.setCell({0, 10}, {true, true, 0});
+    checkDistances(map);
+    // a texture change keeps the field
+    map.setCell({62, 20}, {true, true, 3});
+    checkDistances(map);
+    // an empty map is limited by its border
+    const rc::game::mapCell voids{true, true, 0};
+    Map open(Map::DataType(100, Map::LineType(100, voids)));
+    EXPECT_EQ(open.getDistance({0, 0}), 1);
+    EXPECT_EQ(open.getDistance({50, 50}), Map::maxDistance);
+}
+
+TEST(Map, editorPatterns) {
+    Map map(40, 30);
+    randomArena(map, 3, 12);
+    map.updateDistanceField();
+    // the world editor paints its patterns through setCell
+    we::paintPattern(map, {20, 15}, we::Pattern::Wall2b);
+    EXPECT_EQ(map.at({20, 15}), (Map::BaseType{false, false, 0b101}));
+    EXPECT_TRUE(map.isOpaque({20, 15}));
+    EXPECT_FALSE(map.isInEmptyBlock({20, 15}));
+    checkDistances(map);
+    we::paintPattern(map, {20, 15}, we::Pattern::Passable);
+    we::paintPattern(map, {0, 7}, we::Pattern::Passable);
+    EXPECT_EQ(map.at({20, 15}), (Map::BaseType{true, true, 0}));
+    EXPECT_FALSE(map.isOpaque({20, 15}));
+    checkDistances(map);
+    for (auto pattern: {we::Pattern::Wall1, we::Pattern::Wall1b, we::Pattern::Wall2, we::Pattern::Wall3, we::Pattern::Wall3b}) {
+        EXPECT_FALSE(we::patternCell(pattern).passable);
+        EXPECT_FALSE(we::patternCell(pattern).visibility);
+    }
+}
+
+TEST(Map, occupancy) {
+    const rc::game::mapCell voids{true, true, 0};
+    // 20 x 12 cells: the last blocks are partly outside the map
+    Map map(Map::DataType(12, Map::LineType(20, voids)));
+    EXPECT_FALSE(map.isOpaque({3, 3}));
+    EXPECT_TRUE(map.isInEmptyBlock({3, 3}));
+    EXPECT_FALSE(map.isInEmptyBlock({19, 3}));
+    EXPECT_FALSE(map.isInEmptyBlock({3, 11}));
+    map.setCell({10, 2}, {false, false, 2});
+    EXPECT_TRUE(map.isOpaque({10, 2}));
+    EXPECT_FALSE(map.isInEmptyBlock({15, 7}));
+    EXPECT_TRUE(map.isInEmptyBlock({7, 7}));
+    map.setCell({10, 2}, voids);
+    EXPECT_FALSE(map.isOpaque({10, 2}));
+    EXPECT_TRUE(map.isInEmptyBlock({15, 7}));
+    // reading a cell changes nothing
+    EXPECT_EQ(map.at({4, 4}), voids);
+    EXPECT_FALSE(map.isOpaque({4, 4}));
+    EXPECT_TRUE(map.isInEmptyBlock({0, 0}));
+    map.getMapData()[5 * map.stride() + 6] = {false, false, 2};
+    map.updateOccupancy();
+    EXPECT_TRUE(map.isOpaque({6, 5}));
+    EXPECT_FALSE(map.isInEmptyBlock({0, 0}));
+}
+
+/**
+ * @brief Cast a ray stepping cell by cell, without leaps
+ * @param map The map
+ * @param from Starting point
+ * @param direction Ray's direction
+ * @return Hit data
+ */
+static Map::rayCastResult steppingCast(const Map& map, const Map::worldCoordinates& from, const Map::worldCoordinates& direction) {
+    namespace walk     = rc::game::walk;
+    const auto columns = static_cast<int64_t>(map.stride());
+    const auto lines   = static_cast<int64_t>(map.getMapData().size()) / columns;
+    walk::RayWalk ray{};
+    if (!walk::startWalk(from, direction, map.getCellSize(), columns, ray))
+        return {0, from, false, 0};
+    walk::walkUntil(ray, columns, [&](const walk::RayWalk& current) {
+        return current.cellX < 0 || current.cellY < 0 || current.cellX >= columns || current.cellY >= lines || !map.getMapData().isVisible(static_cast<size_t>(current.idx));
+    });
+    return walk::hitResult(ray, from, direction, map.getCellSize());
+}
+
+TEST(Map, castRaySkipping) {
+    // same hits with the distance field as with the cell by cell walk
+    Map map(300, 200);
+    randomArena(map, 42, 400);
+    map.updateDistanceField();
+    map.updateOccupancy();
+    std::mt19937 gen{3};
+    std::uniform_real_distribution<double> posX{0.0, static_cast<double>(300 * map.getCellSize())};
+    std::uniform_real_distribution<double> posY{0.0, static_cast<double>(200 * map.getCellSize())};
+    std::uniform_real_distribution<double> angle{-1.0, 1.0};
+    for (int r = 0; r < 20000; ++r) {
+        const Map::worldCoordinates from{posX(gen), posY(gen)};
+        const Map::worldCoordinates direction{angle(gen), angle(gen)};
+        const auto cast      = map.castRay(from, direction);
+        const auto reference = steppingCast(map, from, direction);
+        ASSERT_EQ(cast.distance, reference.distance);
+        ASSERT_EQ(cast.wallPoint, reference.wallPoint);
+        ASSERT_EQ(cast.hitVertical, reference.hitVertical);
+        ASSERT_EQ(cast.hitXRatio, reference.hitXRatio);
+    }
+    // axis aligned rays, and rays crossing both grid lines at once
+    for (const Map::worldCoordinates offset : {Map::worldCoordinates{0.5, 0.5}, {0.25, 0.5}, {0.5, 0.25}, {0.75, 0.5}}) {
+        const Map::worldCoordinates from = (Map::worldCoordinates{150, 100} + offset) * 64;
+        for (const Map::worldCoordinates direction : {Map::worldCoordinates{1, 0}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1}, {1, 2}, {-1, 2}, {2, 1}, {2, -1}}) {
+            const auto cast      = map.castRay(from, direction);
+            const auto reference = steppingCast(map, from, direction);
+            EXPECT_EQ(cast.wallPoint, reference.wallPoint);
+            EXPECT_EQ(cast.hitVertical, reference.hitVertical);
+        }
+    }
+}
+
 TEST(Map, saveMap) {
     Map map = ConstructBaseMap();
     map.saveToData("test");
@@ -185,6 +460,8 @@ TEST(Map, saveMap) {
     Map map2;
     map2.loadFromData("test");
     EXPECT_EQ(map2.getCellSize(), map.getCellSize());
+    EXPECT_EQ(map2.stride(), map.stride());
+    EXPECT_EQ(map2.getMapData(), map.getMapData());
     testMap.remove();
     EXPECT_FALSE(testMap.exists());
     testMap.remove();
@@ -204,6 +481,77 @@ TEST(Map, saveMapFile) {
     EXPECT_FALSE(testMap.exists());
 }
 
+TEST(Map, binaryFormat) {
+    Map map = ConstructBaseMap();
+    map.setCell({3, 2}, {map({3, 2}).passable, map({3, 2}).visibility, 5});
+    const auto bytes = map.toBinary();
+    ASSERT_EQ(bytes.size(), Map::binaryHeaderSize + 64);
+    Map map2;
+    ASSERT_TRUE(map2.fromBinary(bytes));
+    EXPECT_EQ(map2.getCellSize(), map.getCellSize());
+    EXPECT_EQ(map2.stride(), map.stride());
+    EXPECT_EQ(map2.getMapData(), map.getMapData());
+    EXPECT_EQ(std::get<0>(map2.getPlayerStart()), std::get<0>(map.getPlayerStart()));
+    EXPECT_EQ(std::get<1>(map2.getPlayerStart()), std::get<1>(map.getPlayerStart()));
+    // cells packed as in json
+    nlohmann::json cell = map({3, 2});
+    EXPECT_EQ(bytes[Map::binaryHeaderSize + 2 * 8 + 3], cell.at(0));
+    // bad data leave an invalid map
+    auto truncated = bytes;
+    truncated.pop_back();
+    EXPECT_FALSE(map2.fromBinary(truncated));
+    EXPECT_FALSE(map2.isValid());
+    auto badVersion = bytes;
+    badVersion[4]   = 0xff;
+    EXPECT_FALSE(map2.fromBinary(badVersion));
+    EXPECT_FALSE(map2.fromBinary({}));
+    auto nullCube = bytes;
+    nullCube[6]   = 0;
+    nullCube[7]   = 0;
+    EXPECT_FALSE(map2.fromBinary(nullCube));
+}
+
+TEST(Map, saveMapBinary) {
+    Map map = ConstructBaseMap();
+    map.saveToData("test", Map::FileFormat::Binary);
+    rc::core::fs::DataFile testMap("maps/test.rcmap");
+    ASSERT_TRUE(testMap.exists());
+    Map map2;
+    map2.loadFromData("test");
+    EXPECT_EQ(map2.getMapData(), map.getMapData());
+    // format detected from the content
+    Map map3;
+    map3.loadFromFile(testMap.getFullPath().string());
+    EXPECT_EQ(map3.getMapData(), map.getMapData());
+    testMap.remove();
+    EXPECT_FALSE(testMap.exists());
+}
+
+TEST(Map, loadNewestFormat) {
+    Map map = ConstructBaseMap();
+    map.saveToData("test", Map::FileFormat::Binary);
+    map.setCell({3, 2}, {map({3, 2}).passable, map({3, 2}).visibility, 5});
+    map.saveToData("test");
+    rc::core::fs::DataFile binary("maps/test.rcmap");
+    rc::core::fs::DataFile json("maps/test.map");
+    // stale binary file: the json one is read
+    std::filesystem::last_write_time(binary.getFullPath(), std::filesystem::last_write_time(json.getFullPath()) - std::chrono::seconds(10));
+    Map map2;
+    map2.loadFromData("test");
+    EXPECT_EQ(map2.getMapData(), map.getMapData());
+    // invalid binary file: the json one is read
+    binary.writeBinary(std::vector<uint8_t>{'R', 'C', 'M', 'P'});
+    Map map3;
+    map3.loadFromData("test");
+    EXPECT_EQ(map3.getMapData(), map.getMapData());
+    // without json file, the map is left invalid
+    json.remove();
+    Map map4;
+    map4.loadFromData("test");
+    EXPECT_FALSE(map4.isValid());
+    binary.remove();
+}
+
 TEST(Map, PassableVisibility) {
     Map map = ConstructBaseMap();
     EXPECT_FALSE(map.isInVisible(Map::gridCoordinate{255, 255}));       // outside
@@ -220,6 +568,20 @@ TEST(Map, PassableVisibility) {
     EXPECT_TRUE(map.isInPassable(Map::worldCoordinates{100, 100}));     // in a visible zone
 }
 
+TEST(Map, textureIds) {
+    Map map = ConstructBaseMap();
+    // walls of ID 10: no texture for it
+    EXPECT_TRUE(map.getTextureIds().empty());
+    map.setCell({0, 1}, {false, false, 4});
+    EXPECT_EQ(map.getTextureIds(), (std::vector<uint8_t>{4}));
+    // the floors' IDs are not drawn as walls
+    map.setCell({1, 1}, {true, true, 6});
+    EXPECT_EQ(map.getTextureIds(), (std::vector<uint8_t>{4}));
+    map.setCell({0, 2}, {false, false, 2});
+    EXPECT_EQ(map.getTextureIds(), (std::vector<uint8_t>{2, 4}));
+    EXPECT_TRUE(Map{}.getTextureIds().empty());
+}
+
 TEST(Map, Colors) {
     rc::game::mapCell cell{true, true, 0};
     EXPECT_EQ(cell.getMapColor(), (rc::graphics::Color{255, 0, 255}));
@@ -245,6 +607,13 @@ TEST(Map, Colors) {
     cell.textureId = 7;
     EXPECT_EQ(cell.getMapColor(), (rc::graphics::Color{0x64, 0x32, 0x08}));
     EXPECT_EQ(cell.getRayColor(), (rc::graphics::Color{0x94, 0x62, 0x38}));
+    EXPECT_TRUE(cell.hasTexture());
+    // unknown IDs use the ones of ID 0
+    cell.textureId = 10;
+    EXPECT_FALSE(cell.hasTexture());
+    EXPECT_EQ(cell.getMapColor(), (rc::graphics::Color{255, 0, 255}));
+    EXPECT_EQ(cell.getRayColor(), (rc::graphics::Color{0, 0, 0}));
+    EXPECT_EQ(cell.getTextureName(), "doorpattern.png");
 }
 
 TEST(Map, possibleMove) {
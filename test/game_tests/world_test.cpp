@@ -0,0 +1,97 @@
+
+#include "core/fs/DataFile.h"
+#include "game/World.h"
+#include "testHelper.h"
+#include <random>
+
+using Map   = rc::game::Map;
+using World = rc::game::World;
+
+/**
+ * @brief Build a map that is not square, with random walls and a solid border
+ * @return The map
+ */
+static Map randomMap() {
+    std::mt19937 gen{17};
+    std::bernoulli_distribution wall{0.05};
+    Map::DataType data(70, Map::LineType(100, rc::game::mapCell{true, true, 0}));
+    for (size_t line = 0; line < data.size(); ++line)
+        for (size_t column = 0; column < data[line].size(); ++column)
+            if (line == 0 || column == 0 || line + 1 == data.size() || column + 1 == data[line].size() || wall(gen))
+                data[line][column] = {false, false, static_cast<uint8_t>(2 + (line + column) % 6)};
+    Map map{data};
+    map.setPlayerStart({3200, 2200}, {1, 0});
+    return map;
+}
+
+TEST(World, open) {
+    World world;
+    EXPECT_FALSE(world.isValid());
+    EXPECT_FALSE(world.openData("doesNotExist"));
+    EXPECT_EQ(world.castRay({10, 10}, {1, 0}).distance, 0);
+    Map map = randomMap();
+    map.saveToData("worldTest", Map::FileFormat::Binary);
+    ASSERT_TRUE(world.openData("worldTest"));
+    EXPECT_TRUE(world.isValid());
+    EXPECT_EQ(world.width(), 100);
+    EXPECT_EQ(world.height(), 70);
+    EXPECT_EQ(world.getCellSize(), 64);
+    EXPECT_EQ(std::get<0>(world.getPlayerStart()), std::get<0>(map.getPlayerStart()));
+    EXPECT_EQ(world.getResidentChunks(), 0);
+    for (Map::IndexType line = 0; line < 70; ++line)
+        for (Map::IndexType column = 0; column < 100; ++column)
+            EXPECT_EQ(world.at({column, line}), map.at({column, line}));
+    // 4 x 3 chunks
+    EXPECT_EQ(world.getResidentChunks(), 12);
+    world.close();
+    EXPECT_FALSE(world.isValid());
+    // a binary file older than the json one is stale
+    map.saveToData("worldTest");
+    const rc::core::fs::DataFile binary("maps/worldTest.rcmap");
+    const rc::core::fs::DataFile json("maps/worldTest.map");
+    std::filesystem::last_write_time(binary.getFullPath(), std::filesystem::last_write_time(json.getFullPath()) - std::chrono::seconds(10));
+    EXPECT_FALSE(Map::isBinaryCurrent("worldTest"));
+    EXPECT_FALSE(world.openData("worldTest"));
+    EXPECT_FALSE(world.isValid());
+    map.saveToData("worldTest", Map::FileFormat::Binary);
+    EXPECT_TRUE(Map::isBinaryCurrent("worldTest"));
+    EXPECT_TRUE(world.openData("worldTest"));
+    binary.remove();
+    json.remove();
+}
+
+TEST(World, sameAsMap) {
+    Map map = randomMap();
+    map.saveToData("worldTest", Map::FileFormat::Binary);
+    World world;
+    ASSERT_TRUE(world.openData("worldTest"));
+    EXPECT_EQ(world.getTextureIds(), map.getTextureIds());
+    // room for two chunks only: rays go through many more
+    world.setMemoryBudget(2 * sizeof(World::Chunk));
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> posX{0.0, 6400.0};
+    std::uniform_real_distribution<double> posY{0.0, 4480.0};
+    std::uniform_real_distribution<double> angle{0.0, 6.2831853};
+    for (size_t i = 0; i < 2000; ++i) {
+        const Map::worldCoordinates from{posX(gen), posY(gen)};
+        const double theta = angle(gen);
+        const Map::worldCoordinates direction{std::cos(theta), std::sin(theta)};
+        world.update(from);
+        const auto expected = map.castRay(from, direction);
+        const auto result   = world.castRay(from, direction);
+        EXPECT_EQ(result.distance, expected.distance);
+        EXPECT_EQ(result.wallPoint, expected.wallPoint);
+        EXPECT_EQ(result.hitVertical, expected.hitVertical);
+        EXPECT_EQ(result.hitXRatio, expected.hitXRatio);
+        EXPECT_EQ(world.whichCell(from), map.whichCell(from));
+        const auto cell = map.whichCell(from);
+        EXPECT_EQ(world.isInPassable(from), cell[0] < 100 && cell[1] < 70 && map.at(cell).passable);
+        EXPECT_LE(world.getMemoryUsage(), world.getMemoryBudget());
+    }
+    EXPECT_EQ(world.getResidentChunks(), 2);
+    // moves are stopped by the walls
+    EXPECT_EQ(world.possibleMove({96, 96}, {-64, 0}), (Map::worldCoordinates{}));
+    EXPECT_EQ(world.possibleMove({96, 96}, {-64, 10}), (Map::worldCoordinates{0, 10}));
+    EXPECT_GT(world.getPageIns(), 12);
+    rc::core::fs::DataFile("maps/worldTest.rcmap").remove();
+}
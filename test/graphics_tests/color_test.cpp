@@ -51,4 +51,6 @@ TEST(Color, darkLight){
     Color color3 = color1.lighter();
     EXPECT_EQ(color2, (Color(90,90,90,255)));
     EXPECT_EQ(color3, (Color(110,110,110,255)));
+    // saturated
+    EXPECT_EQ((Color(240,10,250,255)).lighter(), (Color(255,11,255,255)));
 }
@@ -0,0 +1,79 @@
+
+#include "graphics/Pixels.h"
+#include "testHelper.h"
+#include <vector>
+
+using Color = rc::graphics::Color;
+
+TEST(Pixels, pack) {
+    const Color color{1, 2, 3, 4};
+    EXPECT_EQ(rc::graphics::unpack(rc::graphics::pack(color)), color);
+    EXPECT_EQ(rc::graphics::pack(color) >> rc::graphics::greenShift & 0xFFU, 2);
+    EXPECT_EQ(rc::graphics::pack(color) >> rc::graphics::alphaShift & 0xFFU, 4);
+}
+
+TEST(Pixels, fill) {
+    std::vector<Color> pixels(37);
+    rc::graphics::fillPixels(std::span(pixels).subspan(1, 35), {5, 6, 7});
+    EXPECT_EQ(pixels.front(), Color{});
+    EXPECT_EQ(pixels[1], (Color{5, 6, 7}));
+    EXPECT_EQ(pixels[35], (Color{5, 6, 7}));
+    EXPECT_EQ(pixels.back(), Color{});
+}
+
+TEST(Pixels, darken) {
+    // same result as Color::darken for every channel value
+    std::vector<Color> pixels;
+    for (uint32_t value = 0; value < 256; ++value) {
+        const auto channel = static_cast<uint8_t>(value);
+        pixels.emplace_back(channel, static_cast<uint8_t>(255 - value), channel, static_cast<uint8_t>(value / 2));
+    }
+    std::vector<Color> darker(pixels.size());
+    rc::graphics::darkenPixels(pixels, darker);
+    rc::graphics::darkenPixels(pixels);
+    for (size_t i = 0; i < darker.size(); ++i) {
+        EXPECT_EQ(pixels[i], darker[i]);
+        auto expected = Color(static_cast<uint8_t>(i), static_cast<uint8_t>(255 - i), static_cast<uint8_t>(i), static_cast<uint8_t>(i / 2));
+        EXPECT_EQ(darker[i], expected.darken());
+    }
+}
+
+TEST(Pixels, blend) {
+    const std::vector<Color> source{{200, 100, 0, 255}, {200, 100, 0, 0}, {200, 100, 0, 128}};
+    std::vector<Color> dest(3, Color{0, 50, 255, 255});
+    rc::graphics::blendPixels(source, dest);
+    EXPECT_EQ(dest[0], source[0]);
+    EXPECT_EQ(dest[1], (Color{0, 50, 255, 255}));
+    EXPECT_EQ(dest[2], (Color{100, 75, 127, 255}));
+}
+
+TEST(Pixels, swapRedBlue) {
+    std::vector<Color> pixels{{1, 2, 3, 4}, {10, 20, 30, 40}};
+    rc::graphics::swapRedBlue(pixels);
+    EXPECT_EQ(pixels[0], (Color{3, 2, 1, 4}));
+    EXPECT_EQ(pixels[1], (Color{30, 20, 10, 40}));
+    rc::graphics::swapRedBlue(pixels);
+    EXPECT_EQ(pixels[1], (Color{10, 20, 30, 40}));
+}
+
+TEST(Pixels, unpack) {
+    const std::vector<uint8_t> bytes{10, 20, 30, 40, 50, 60, 70, 80};
+    std::vector<Color> pixels(2);
+    rc::graphics::unpackPixels(bytes, 1, pixels);
+    EXPECT_EQ(pixels[1], (Color{20, 20, 20, 255}));
+    rc::graphics::unpackPixels(bytes, 2, pixels);
+    EXPECT_EQ(pixels[1], (Color{30, 30, 30, 40}));
+    rc::graphics::unpackPixels(bytes, 3, pixels);
+    EXPECT_EQ(pixels[1], (Color{40, 50, 60, 255}));
+    rc::graphics::unpackPixels(bytes, 4, pixels);
+    EXPECT_EQ(pixels[0], (Color{10, 20, 30, 40}));
+    EXPECT_EQ(pixels[1], (Color{50, 60, 70, 80}));
+    // strided write, as into a column major image
+    std::vector<Color> column(4);
+    rc::graphics::unpackPixels(bytes, 4, column, 3);
+    EXPECT_EQ(column[0], (Color{10, 20, 30, 40}));
+    EXPECT_EQ(column[1], Color{});
+    EXPECT_EQ(column[3], (Color{50, 60, 70, 80}));
+    rc::graphics::unpackPixels(bytes, 3, column, 3);
+    EXPECT_EQ(column[3], (Color{40, 50, 60, 255}));
+}
@@ -0,0 +1,81 @@
+
+#include "graphics/Rasterizer.h"
+#include "testHelper.h"
+
+using Color   = rc::graphics::Color;
+using Texture = rc::graphics::image::Texture;
+
+TEST(Rasterizer, fillColumn) {
+    Texture target(4, 16);
+    rc::graphics::fillColumn(target, 1, 4, 8, {10, 20, 30});
+    EXPECT_EQ(target.getPixel(1, 3), (Color{0, 0, 0}));
+    EXPECT_EQ(target.getPixel(1, 4), (Color{10, 20, 30}));
+    EXPECT_EQ(target.getPixel(1, 7), (Color{10, 20, 30}));
+    EXPECT_EQ(target.getPixel(1, 8), (Color{0, 0, 0}));
+    EXPECT_EQ(target.getPixel(2, 5), (Color{0, 0, 0}));
+    // clipped
+    rc::graphics::fillColumn(target, 2, -10, 100, {1, 1, 1});
+    EXPECT_EQ(target.getPixel(2, 0), (Color{1, 1, 1}));
+    EXPECT_EQ(target.getPixel(2, 15), (Color{1, 1, 1}));
+    rc::graphics::fillColumn(target, 3, 10, 5, {1, 1, 1});
+    EXPECT_EQ(target.getPixel(3, 7), (Color{0, 0, 0}));
+}
+
+TEST(Rasterizer, wallColumn) {
+    Texture tex(2, 4);
+    for (uint16_t v = 0; v < 4; ++v)
+        tex.getPixel(1, v) = {static_cast<uint8_t>(v * 50), 100, 100};
+    Texture target(2, 16);
+    // magnified twice, starting above the clipping range
+    rc::graphics::drawWallColumn(target, 0, -2, 8, tex, 1, 0, 16, false);
+    EXPECT_EQ(target.getPixel(0, 0), tex.getPixel(1, 1));
+    EXPECT_EQ(target.getPixel(0, 2), tex.getPixel(1, 2));
+    EXPECT_EQ(target.getPixel(0, 5), tex.getPixel(1, 3));
+    EXPECT_EQ(target.getPixel(0, 6), (Color{0, 0, 0}));
+    rc::graphics::drawWallColumn(target, 1, 4, 4, tex, 5, 0, 6, true);
+    EXPECT_EQ(target.getPixel(1, 3), (Color{0, 0, 0}));
+    EXPECT_EQ(target.getPixel(1, 4), tex.getPixel(1, 0).darker());
+    EXPECT_EQ(target.getPixel(1, 5), tex.getPixel(1, 1).darker());
+    EXPECT_EQ(target.getPixel(1, 6), (Color{0, 0, 0}));
+}
+
+TEST(Rasterizer, wallColumnLayouts) {
+    Texture tex(4, 8);
+    for (uint16_t u = 0; u < 4; ++u)
+        for (uint16_t v = 0; v < 8; ++v)
+            tex.getPixel(u, v) = {static_cast<uint8_t>(u * 60), static_cast<uint8_t>(v * 30), 90};
+    Texture reference(1, 12);
+    rc::graphics::drawWallColumn(reference, 0, 2, 8, tex, 2, 0, 12, true);
+    // pre-shaded texels give the same result
+    tex.buildShadedCopy();
+    Texture shaded(1, 12);
+    rc::graphics::drawWallColumn(shaded, 0, 2, 8, tex, 2, 0, 12, true);
+    // row-major texture and frame buffer
+    tex.setLayout(Texture::Layout::RowMajor);
+    Texture rows(3, 12);
+    rows.setLayout(Texture::Layout::RowMajor);
+    rc::graphics::drawWallColumn(rows, 1, 2, 8, tex, 2, 0, 12, true);
+    for (uint16_t v = 0; v < 12; ++v) {
+        EXPECT_EQ(shaded.getPixel(0, v), reference.getPixel(0, v));
+        EXPECT_EQ(rows.getPixel(1, v), reference.getPixel(0, v));
+    }
+    EXPECT_EQ(reference.getPixel(0, 2), tex.getPixel(2, 0).darker());
+}
+
+TEST(Rasterizer, wallColumnMipmaps) {
+    Texture tex(8, 8, {0, 0, 0});
+    for (uint16_t u = 0; u < 8; ++u)
+        for (uint16_t v = 0; v < 8; ++v)
+            if ((u + v) % 2 == 0)
+                tex.getPixel(u, v) = {200, 100, 40};
+    Texture target(2, 4);
+    tex.buildMipmaps();
+    // a 2-pixel high wall reads the 2x2 level: the checkerboard's average
+    rc::graphics::drawWallColumn(target, 0, 1, 2, tex, 5, 0, 4, false);
+    EXPECT_EQ(target.getPixel(0, 1), tex.getMipmap(2).getPixel(1, 0));
+    EXPECT_NE(target.getPixel(0, 1), tex.getPixel(5, 1));
+    EXPECT_NE(target.getPixel(0, 1), tex.getPixel(5, 0));
+    // a tall wall still reads the full texture
+    rc::graphics::drawWallColumn(target, 1, 0, 8, tex, 5, 0, 4, false);
+    EXPECT_EQ(target.getPixel(1, 0), tex.getPixel(5, 0));
+}
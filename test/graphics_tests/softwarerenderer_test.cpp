@@ -0,0 +1,134 @@
+/**
+ * @file softwarerenderer_test.cpp
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "graphics/image/TextureManager.h"
+#include "graphics/renderer/SoftwareRenderer.h"
+#include "testHelper.h"
+
+using namespace rc::graphics::renderer;
+using Color = rc::graphics::Color;
+
+TEST(SoftwareRenderer, base) {
+    SoftwareRenderer renderer;
+    renderer.settings().ScreenResolution = {64, 32};
+    renderer.settings().Background       = {10, 20, 30};
+    EXPECT_EQ(renderer.getType(), RendererType::Software);
+    EXPECT_EQ(renderer.getStatus(), Status::Uninitialized);
+    renderer.Init();
+    EXPECT_EQ(renderer.getStatus(), Status::Ready);
+    EXPECT_EQ(renderer.getFrame().width(), 64);
+    EXPECT_EQ(renderer.getFrame().height(), 32);
+    EXPECT_EQ(renderer.getFrame().getPixel(5, 5), (Color{10, 20, 30}));
+    // not running: nothing is drawn
+    renderer.drawQuad({{0, 0}, {64, 0}, {64, 32}, {0, 32}}, {255, 0, 0});
+    EXPECT_EQ(renderer.getFrame().getPixel(5, 5), (Color{10, 20, 30}));
+    renderer.start();
+    EXPECT_EQ(renderer.getStatus(), Status::Running);
+}
+
+TEST(SoftwareRenderer, primitives) {
+    SoftwareRenderer renderer;
+    renderer.settings().ScreenResolution = {64, 32};
+    renderer.settings().Background       = {0, 0, 0};
+    renderer.Init();
+    renderer.start();
+    renderer.drawQuad({{10, 10}, {20, 10}, {20, 20}, {10, 20}}, {255, 0, 0});
+    EXPECT_EQ(renderer.getFrame().getPixel(10, 10), (Color{255, 0, 0}));
+    EXPECT_EQ(renderer.getFrame().getPixel(19, 19), (Color{255, 0, 0}));
+    EXPECT_EQ(renderer.getFrame().getPixel(20, 20), (Color{0, 0, 0}));
+    EXPECT_EQ(renderer.getFrame().getPixel(9, 15), (Color{0, 0, 0}));
+    renderer.drawLine({{0, 2}, {63, 2}}, 1, {0, 255, 0});
+    EXPECT_EQ(renderer.getFrame().getPixel(0, 2), (Color{0, 255, 0}));
+    EXPECT_EQ(renderer.getFrame().getPixel(63, 2), (Color{0, 255, 0}));
+    EXPECT_EQ(renderer.getFrame().getPixel(30, 3), (Color{0, 0, 0}));
+    renderer.drawPoint({40.5, 25.5}, 3, {0, 0, 255});
+    EXPECT_EQ(renderer.getFrame().getPixel(39, 24), (Color{0, 0, 255}));
+    EXPECT_EQ(renderer.getFrame().getPixel(41, 26), (Color{0, 0, 255}));
+    EXPECT_EQ(renderer.getFrame().getPixel(42, 26), (Color{0, 0, 0}));
+    // out of screen drawing is clipped
+    renderer.drawQuad({{-100, -100}, {100, -100}, {100, 100}, {-100, 100}}, {1, 2, 3});
+    EXPECT_EQ(renderer.getFrame().getPixel(0, 0), (Color{1, 2, 3}));
+    EXPECT_EQ(renderer.getFrame().getPixel(63, 31), (Color{1, 2, 3}));
+}
+
+TEST(SoftwareRenderer, textureLine) {
+    auto& texMng = rc::graphics::image::TextureManager::get();
+    const auto& tex = texMng.getTexture("brickpattern.png");
+    ASSERT_EQ(tex.height(), 64);
+    SoftwareRenderer renderer;
+    renderer.settings().ScreenResolution = {64, 128};
+    renderer.Init();
+    renderer.start();
+    const rc::math::geometry::Box2 layout{{0, 0}, {64, 128}};
+    renderer.drawTextureVerticalLine(3, 0, 64, tex, 3, layout);
+    renderer.drawTextureVerticalLine(4, 0, 64, tex, 3, layout, true);
+    for (uint16_t v = 0; v < 64; ++v) {
+        EXPECT_EQ(renderer.getFrame().getPixel(3, v), tex.getPixel(3, v));
+        EXPECT_EQ(renderer.getFrame().getPixel(4, v), tex.getPixel(3, v).darker());
+    }
+    // line larger than the layout
+    renderer.drawTextureVerticalLine(5, -64, 256, tex, 3, layout);
+    EXPECT_EQ(renderer.getFrame().getPixel(5, 0), tex.getPixel(3, 16));
+    texMng.unloadAll();
+}
+
+TEST(SoftwareRenderer, image) {
+    SoftwareRenderer renderer;
+    renderer.settings().ScreenResolution = {32, 16};
+    renderer.Init();
+    renderer.start();
+    rc::graphics::image::Texture image(8, 8, {1, 2, 3});
+    image.getPixel(0, 0) = {200, 0, 0};
+    image.getPixel(7, 7) = {0, 200, 0};
+    renderer.drawImage(image, {{4, 2}, {32, 16}});
+    EXPECT_EQ(renderer.getFrame().getPixel(4, 2), (Color{200, 0, 0}));
+    EXPECT_EQ(renderer.getFrame().getPixel(11, 9), (Color{0, 200, 0}));
+    EXPECT_EQ(renderer.getFrame().getPixel(8, 5), (Color{1, 2, 3}));
+    EXPECT_EQ(renderer.getFrame().getPixel(3, 2), renderer.settings().Background);
+    EXPECT_EQ(renderer.getFrame().getPixel(12, 9), renderer.settings().Background);
+    // clipped to the layout and to the screen
+    image.getPixel(1, 7) = {0, 0, 200};
+    renderer.drawImage(image, {{28, -2}, {30, 16}});
+    EXPECT_EQ(renderer.getFrame().getPixel(29, 5), (Color{0, 0, 200}));
+    EXPECT_EQ(renderer.getFrame().getPixel(30, 5), renderer.settings().Background);
+    EXPECT_EQ(renderer.getFrame().getPixel(28, 0), (Color{1, 2, 3}));
+}
+
+TEST(SoftwareRenderer, frameDump) {
+    SoftwareRenderer renderer;
+    renderer.settings().ScreenResolution = {16, 8};
+    renderer.Init();
+    renderer.setDrawingCallback([&renderer]() { renderer.drawQuad({{0, 0}, {8, 0}, {8, 8}, {0, 8}}, {200, 100, 50}); });
+    renderer.start();
+    renderer.renderFrame();
+    EXPECT_EQ(renderer.getFrameCount(), 1);
+    EXPECT_EQ(renderer.getFrame().getPixel(2, 2), (Color{200, 100, 50}));
+    rc::core::fs::DataFile file("textures/frameDump.png");
+    renderer.saveFrame(file);
+    ASSERT_TRUE(file.exists());
+    rc::graphics::image::Texture dump;
+    dump.loadFromFile("frameDump.png");
+    EXPECT_EQ(dump.width(), 16);
+    EXPECT_EQ(dump.height(), 8);
+    EXPECT_EQ(dump.getPixel(2, 2), (Color{200, 100, 50}));
+    EXPECT_EQ(dump.getPixel(12, 2), renderer.settings().Background);
+    file.remove();
+}
+
+TEST(SoftwareRenderer, frameLoop) {
+    SoftwareRenderer renderer;
+    renderer.settings().ScreenResolution = {16, 8};
+    renderer.settings().FrameLimit       = 3;
+    renderer.Init();
+    uint64_t drawn = 0;
+    renderer.setDrawingCallback([&drawn]() { ++drawn; });
+    renderer.run();
+    EXPECT_EQ(renderer.getStatus(), Status::Running);
+    EXPECT_EQ(renderer.getFrameCount(), 3);
+    EXPECT_EQ(drawn, 3);
+}
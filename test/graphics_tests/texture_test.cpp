@@ -44,6 +44,10 @@ TEST(Texture, LoadSavePNG){
 
 
 TEST(Texture, Column) {
+    if (!rc::core::tool::Tracker::enabled)
+        GTEST_SKIP() << "Memory tracker compiled out";
+    // the data folder is searched once, the first time a data file is used
+    rc::core::fs::DataFile::getDataPath();
     rc::core::tool::Tracker::get().checkState();
     Texture baseTex;
     baseTex.loadFromFile("brickpattern.png");
@@ -56,3 +60,74 @@ TEST(Texture, Column) {
     EXPECT_EQ(res.m_allocationCalls, 26);
 #endif
 }
+
+TEST(Texture, Layout) {
+    Texture tex(3, 2);
+    tex.getPixel(2, 0) = {1, 2, 3};
+    tex.getPixel(0, 1) = {4, 5, 6};
+    EXPECT_EQ(tex.getLayout(), Texture::Layout::ColumnMajor);
+    EXPECT_EQ(tex.columnStride(), 1);
+    EXPECT_EQ(tex.data()[tex.pixelIndex(2, 0)], rc::graphics::Color(1, 2, 3));
+    EXPECT_EQ(tex.pixelIndex(2, 0), 4);
+    tex.setLayout(Texture::Layout::RowMajor);
+    EXPECT_EQ(tex.getLayout(), Texture::Layout::RowMajor);
+    EXPECT_EQ(tex.columnStride(), 3);
+    EXPECT_EQ(tex.pixelIndex(2, 0), 2);
+    EXPECT_EQ(tex.data()[2], rc::graphics::Color(1, 2, 3));
+    EXPECT_EQ(tex.getPixel(0, 1), rc::graphics::Color(4, 5, 6));
+    EXPECT_EQ(tex.data()[3], rc::graphics::Color(4, 5, 6));
+    tex.setLayout(Texture::Layout::ColumnMajor);
+    EXPECT_EQ(tex.getPixel(2, 0), rc::graphics::Color(1, 2, 3));
+    EXPECT_EQ(tex.getPixel(0, 1), rc::graphics::Color(4, 5, 6));
+}
+
+TEST(Texture, ShadedCopy) {
+    Texture tex(4, 4, {100, 200, 50});
+    EXPECT_FALSE(tex.hasShadedCopy());
+    EXPECT_EQ(tex.memorySize(), 64);
+    tex.buildShadedCopy();
+    EXPECT_TRUE(tex.hasShadedCopy());
+    EXPECT_EQ(tex.memorySize(), 128);
+    EXPECT_EQ(tex.shadedData()[5], rc::graphics::Color(100, 200, 50).darker());
+    tex.fill({10, 20, 30});
+    EXPECT_EQ(tex.shadedData()[5], rc::graphics::Color(10, 20, 30).darker());
+    tex.getPixel(1, 1) = {0, 0, 0};
+    tex.setLayout(Texture::Layout::RowMajor);
+    EXPECT_EQ(tex.shadedData()[tex.pixelIndex(1, 1)], rc::graphics::Color(10, 20, 30).darker());
+    tex.dropShadedCopy();
+    EXPECT_FALSE(tex.hasShadedCopy());
+    EXPECT_EQ(tex.memorySize(), 64);
+}
+
+TEST(Texture, Mipmaps) {
+    Texture tex(64, 16, {100, 200, 50});
+    EXPECT_EQ(tex.mipmapCount(), 0);
+    EXPECT_EQ(&tex.getMipmapFor(2), &tex);
+    tex.buildMipmaps();
+    EXPECT_EQ(tex.mipmapCount(), 6);
+    EXPECT_EQ(tex.getMipmap(1).width(), 32);
+    EXPECT_EQ(tex.getMipmap(1).height(), 8);
+    EXPECT_EQ(tex.getMipmap(6).width(), 1);
+    EXPECT_EQ(tex.getMipmap(6).height(), 1);
+    EXPECT_EQ(&tex.getMipmap(10), &tex.getMipmap(6));
+    EXPECT_EQ(tex.getMipmap(3).getPixel(2, 1), rc::graphics::Color(100, 200, 50));
+    // a third more memory
+    EXPECT_EQ(tex.memorySize(), (64 * 16 + 32 * 8 + 16 * 4 + 8 * 2 + 4 + 2 + 1) * 4);
+    // the smallest level still taller than the drawn line
+    EXPECT_EQ(&tex.getMipmapFor(20), &tex);
+    EXPECT_EQ(&tex.getMipmapFor(8), &tex.getMipmap(1));
+    EXPECT_EQ(&tex.getMipmapFor(3), &tex.getMipmap(2));
+    EXPECT_EQ(&tex.getMipmapFor(0.5), &tex.getMipmap(6));
+    // box filter
+    Texture checker(2, 2, {0, 0, 0});
+    checker.getPixel(0, 0) = {200, 100, 40};
+    checker.getPixel(1, 1) = {200, 100, 40};
+    checker.buildMipmaps();
+    EXPECT_EQ(checker.getMipmap(1).getPixel(0, 0), checker.getPixel(0, 0, 1));
+    tex.buildShadedCopy();
+    EXPECT_TRUE(tex.getMipmap(2).hasShadedCopy());
+    tex.fill({10, 20, 30});
+    EXPECT_EQ(tex.getMipmap(2).getPixel(1, 1), rc::graphics::Color(10, 20, 30));
+    tex.dropMipmaps();
+    EXPECT_EQ(tex.mipmapCount(), 0);
+}
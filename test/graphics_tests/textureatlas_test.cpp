@@ -0,0 +1,69 @@
+
+#include "graphics/image/TextureAtlas.h"
+#include "testHelper.h"
+
+using Color        = rc::graphics::Color;
+using Texture      = rc::graphics::image::Texture;
+using TextureAtlas = rc::graphics::image::TextureAtlas;
+
+TEST(TextureAtlas, base) {
+    TextureAtlas atlas;
+    EXPECT_FALSE(atlas.contains(3));
+    EXPECT_TRUE(atlas.getView(3).empty());
+    EXPECT_EQ(atlas.size(), 0);
+    Texture tex(4, 8);
+    for (uint16_t u = 0; u < 4; ++u)
+        for (uint16_t v = 0; v < 8; ++v)
+            tex.getPixel(u, v) = {static_cast<uint8_t>(u * 60), static_cast<uint8_t>(v * 30), 90};
+    atlas.add(3, tex);
+    EXPECT_TRUE(atlas.contains(3));
+    EXPECT_EQ(atlas.levelCount(3), 1);
+    EXPECT_EQ(atlas.size(), 32);
+    EXPECT_EQ(atlas.memorySize(), 128);
+    const auto& view = atlas.getView(3);
+    EXPECT_EQ(view.width, 4);
+    EXPECT_EQ(view.height, 8);
+    EXPECT_EQ(view.shaded, nullptr);
+    EXPECT_EQ(view.pixels[2 * view.rowStride + 5 * view.columnStride], tex.getPixel(2, 5));
+    // a row-major texture is stored column-major
+    tex.setLayout(Texture::Layout::RowMajor);
+    atlas.add(7, tex);
+    const auto& rows = atlas.getView(7);
+    EXPECT_EQ(rows.columnStride, 1);
+    EXPECT_EQ(rows.pixels[3 * rows.rowStride + 6], tex.getPixel(3, 6));
+    // slots already used are kept
+    atlas.add(3, Texture(2, 2));
+    EXPECT_EQ(atlas.getView(3).width, 4);
+    // out of range
+    atlas.add(TextureAtlas::slotCount, tex);
+    EXPECT_FALSE(atlas.contains(TextureAtlas::slotCount));
+    atlas.clear();
+    EXPECT_FALSE(atlas.contains(3));
+    EXPECT_EQ(atlas.size(), 0);
+}
+
+TEST(TextureAtlas, levels) {
+    Texture tex(16, 16, {100, 150, 200});
+    tex.buildMipmaps();
+    tex.buildShadedCopy();
+    Texture other(8, 8, {1, 2, 3});
+    TextureAtlas atlas;
+    atlas.add(1, tex);
+    atlas.add(2, other);
+    EXPECT_EQ(atlas.levelCount(1), 5);
+    EXPECT_EQ(atlas.size(), 2 * (16 * 16 + 8 * 8 + 4 * 4 + 2 * 2 + 1) + 8 * 8);
+    // every level lies in the block
+    for (size_t level = 0; level < atlas.levelCount(1); ++level) {
+        const auto& view = atlas.getView(1, level);
+        EXPECT_GE(view.pixels, atlas.data());
+        EXPECT_LE(view.shaded + view.width * view.height, atlas.data() + atlas.size());
+        EXPECT_EQ(view.width, tex.getMipmap(level).width());
+        EXPECT_EQ(view.shaded[0], Color(100, 150, 200).darker());
+    }
+    EXPECT_EQ(&atlas.getView(1, 10), &atlas.getView(1, 4));
+    // same level choice as the texture
+    for (double height : {40.0, 16.0, 9.0, 8.0, 3.0, 0.5})
+        EXPECT_EQ(atlas.getViewFor(1, height).height, tex.getMipmapFor(height).height());
+    EXPECT_EQ(atlas.getViewFor(2, 1.0).height, 8);
+    EXPECT_EQ(atlas.getView(2).pixels[5], Color(1, 2, 3));
+}
@@ -50,13 +50,13 @@ TEST(TextureManager, memoryClean){
     EXPECT_EQ(tex.width(), 64);
     EXPECT_EQ(tex.height(), 64);
     EXPECT_EQ(texMng.getLoadedTextureCount(), 1);
-    EXPECT_NEAR(texMng.getMemoryPercentage(), 66.83, 0.01);
+    EXPECT_NEAR(texMng.getMemoryPercentage(), 67.06, 0.01);
     // load a second texture... should unload the first one
     auto tex2 = texMng.getTexture("doorpattern.png");
     EXPECT_EQ(tex.width(), 64);
     EXPECT_EQ(tex.height(), 64);
     EXPECT_EQ(texMng.getLoadedTextureCount(), 1);
-    EXPECT_NEAR(texMng.getMemoryPercentage(), 66.83, 0.01);
+    EXPECT_NEAR(texMng.getMemoryPercentage(), 67.06, 0.01);
     // reset limit to default
     texMng.setMemoryLimit(memLimit);
     // should have 2 textures in manager
@@ -69,3 +69,212 @@ TEST(TextureManager, memoryClean){
     texMng.unloadAll();
     EXPECT_EQ(texMng.getLoadedTextureCount(), 0);
 }
+
+TEST(TextureManager, shadedCopies){
+    auto& texMng = TextureManager::get();
+    EXPECT_FALSE(texMng.hasShadedCopies());
+    const auto& tex = texMng.getTexture("brickpattern.png");
+    EXPECT_FALSE(tex.hasShadedCopy());
+    const size_t plain = texMng.getMemoryUsage();
+    // the copy doubles the pixels' memory
+    texMng.setShadedCopies(true);
+    EXPECT_TRUE(tex.hasShadedCopy());
+    EXPECT_EQ(texMng.getMemoryUsage(), plain + 64 * 64 * 4);
+    const auto& tex2 = texMng.getTexture("doorpattern.png");
+    EXPECT_TRUE(tex2.hasShadedCopy());
+    EXPECT_EQ(texMng.getMemoryUsage(), 2 * plain + 2 * 64 * 64 * 4);
+    texMng.setShadedCopies(false);
+    EXPECT_FALSE(tex.hasShadedCopy());
+    EXPECT_EQ(texMng.getMemoryUsage(), 2 * plain);
+    texMng.unloadAll();
+}
+
+TEST(TextureManager, mipmaps){
+    auto& texMng = TextureManager::get();
+    EXPECT_FALSE(texMng.hasMipmaps());
+    const auto& tex = texMng.getTexture("brickpattern.png");
+    EXPECT_EQ(tex.mipmapCount(), 0);
+    const size_t plain = texMng.getMemoryUsage();
+    // levels from 32x32 down to 1x1
+    constexpr size_t levels = (32 * 32 + 16 * 16 + 8 * 8 + 4 * 4 + 2 * 2 + 1) * 4;
+    texMng.setMipmaps(true);
+    EXPECT_EQ(tex.mipmapCount(), 6);
+    EXPECT_EQ(texMng.getMemoryUsage(), plain + levels);
+    const auto& tex2 = texMng.getTexture("doorpattern.png");
+    EXPECT_EQ(tex2.mipmapCount(), 6);
+    EXPECT_EQ(texMng.getMemoryUsage(), 2 * plain + 2 * levels);
+    texMng.setMipmaps(false);
+    EXPECT_EQ(tex.mipmapCount(), 0);
+    EXPECT_EQ(texMng.getMemoryUsage(), 2 * plain);
+    texMng.unloadAll();
+}
+
+TEST(TextureManager, handles){
+    auto& texMng = TextureManager::get();
+    EXPECT_FALSE(texMng.getHandle("").isValid());
+    EXPECT_EQ(texMng.getTexture(rc::graphics::image::TextureHandle{}).width(), 0);
+    // resolving a name does not load it
+    const auto brick = texMng.getHandle("brickpattern.png");
+    EXPECT_TRUE(brick.isValid());
+    EXPECT_EQ(texMng.getHandle("brickpattern.png"), brick);
+    EXPECT_EQ(texMng.getLoadedTextureCount(), 0);
+    const auto& tex = texMng.getTexture(brick);
+    EXPECT_EQ(tex.width(), 64);
+    EXPECT_EQ(&texMng.getTexture("brickpattern.png"), &tex);
+    EXPECT_EQ(texMng.getLoadedTextureCount(), 1);
+    // handles survive the unloading, the texture is loaded again on use
+    texMng.unloadAll();
+    EXPECT_EQ(texMng.getLoadedTextureCount(), 0);
+    EXPECT_EQ(texMng.getTexture(brick).width(), 64);
+    EXPECT_EQ(texMng.getLoadedTextureCount(), 1);
+    texMng.unloadAll();
+}
+
+TEST(TextureManager, leastRecentlyUsed){
+    auto& texMng = TextureManager::get();
+    const size_t memLimit = texMng.getMemoryLimit();
+    const auto brick  = texMng.getHandle("brickpattern.png");
+    const auto door   = texMng.getHandle("doorpattern.png");
+    const auto purple = texMng.getHandle("purplestone.png");
+    texMng.newFrame();
+    texMng.getTexture(brick);
+    texMng.getTexture(door);
+    // room for two 64x64 textures
+    texMng.setMemoryLimit(2 * (64 * 64 * 4 + sizeof(rc::graphics::image::Texture)));
+    // brick is used again in a later frame: door is now the oldest
+    texMng.newFrame();
+    texMng.getTexture(brick);
+    texMng.getTexture(purple);
+    EXPECT_EQ(texMng.getLoadedTextureCount(), 2);
+    EXPECT_TRUE(texMng.isLoaded(brick));
+    EXPECT_FALSE(texMng.isLoaded(door));
+    // many uses in a frame count once
+    texMng.newFrame();
+    texMng.getTexture(brick);
+    texMng.getTexture(purple);
+    texMng.getTexture(brick);
+    texMng.getTexture(door);
+    EXPECT_FALSE(texMng.isLoaded(brick));
+    EXPECT_TRUE(texMng.isLoaded(purple));
+    EXPECT_TRUE(texMng.isLoaded(door));
+    texMng.setMemoryLimit(memLimit);
+    texMng.unloadAll();
+}
+
+TEST(TextureManager, backgroundLoading){
+    auto& texMng = TextureManager::get();
+    texMng.unloadAll();
+    texMng.resetLoadingStats();
+    // loaded when first drawn: a hitch
+    const auto brick = texMng.getHandle("brickpattern.png");
+    EXPECT_EQ(texMng.getTexture(brick).width(), 64);
+    EXPECT_EQ(texMng.getLoadingStats().hitches, 1);
+    EXPECT_EQ(texMng.getLoadingStats().loads, 1);
+    // prefetched: no hitch
+    const auto door = texMng.getHandle("doorpattern.png");
+    texMng.prefetch(door);
+    EXPECT_TRUE(texMng.isLoaded(door));
+    EXPECT_EQ(texMng.getLoadingStats().hitches, 1);
+    texMng.unloadAll();
+    texMng.resetLoadingStats();
+    // in the background: a placeholder until taken in by a new frame
+    texMng.setLoaderThreads(2);
+    EXPECT_EQ(texMng.getLoaderThreads(), 2);
+    EXPECT_EQ(texMng.getTexture(brick).width(), 1);
+    EXPECT_EQ(texMng.getTexture(brick).width(), 1);
+    EXPECT_FALSE(texMng.isLoaded(brick));
+    texMng.prefetch(door);
+    texMng.waitForLoads();
+    EXPECT_TRUE(texMng.isLoaded(brick));
+    EXPECT_TRUE(texMng.isLoaded(door));
+    EXPECT_EQ(texMng.getTexture(brick).width(), 64);
+    const auto& stats = texMng.getLoadingStats();
+    EXPECT_EQ(stats.hitches, 0);
+    EXPECT_EQ(stats.placeholders, 2);
+    EXPECT_EQ(stats.loads, 2);
+    EXPECT_GT(stats.maxLatency, 0.0);
+    EXPECT_LE(stats.meanLatency(), stats.maxLatency);
+    // loads requested before an unloadAll are dropped
+    texMng.unloadAll();
+    texMng.getTexture(brick);
+    texMng.unloadAll();
+    texMng.waitForLoads();
+    EXPECT_EQ(texMng.getLoadedTextureCount(), 0);
+    EXPECT_EQ(texMng.getMemoryUsage(), 0);
+    texMng.setLoaderThreads(0);
+    EXPECT_EQ(texMng.getLoaderThreads(), 0);
+    texMng.resetLoadingStats();
+}
+
+TEST(TextureManager, pinning){
+    auto& texMng = TextureManager::get();
+    texMng.unloadAll();
+    const size_t memLimit = texMng.getMemoryLimit();
+    const auto brick  = texMng.getHandle("brickpattern.png");
+    const auto door   = texMng.getHandle("doorpattern.png");
+    const auto purple = texMng.getHandle("purplestone.png");
+    texMng.pin(brick);
+    EXPECT_TRUE(texMng.isPinned(brick));
+    EXPECT_TRUE(texMng.isLoaded(brick));
+    // room for one 64x64 texture: the pinned one stays
+    const size_t textureMemory = 64 * 64 * 4 + sizeof(rc::graphics::image::Texture);
+    texMng.setMemoryLimit(textureMemory);
+    texMng.newFrame();
+    texMng.getTexture(door);
+    EXPECT_TRUE(texMng.isLoaded(brick));
+    EXPECT_FALSE(texMng.isLoaded(door));
+    // unpinned: evictable again, as the oldest
+    texMng.setMemoryLimit(2 * textureMemory);
+    texMng.unpin(brick);
+    EXPECT_FALSE(texMng.isPinned(brick));
+    texMng.newFrame();
+    texMng.getTexture(door);
+    texMng.getTexture(purple);
+    EXPECT_FALSE(texMng.isLoaded(brick));
+    EXPECT_TRUE(texMng.isLoaded(door));
+    EXPECT_TRUE(texMng.isLoaded(purple));
+    texMng.setMemoryLimit(memLimit);
+    texMng.unloadAll();
+}
+
+TEST(TextureManager, memoryAccounting){
+    auto& texMng = TextureManager::get();
+    texMng.unloadAll();
+    const size_t memLimit = texMng.getMemoryLimit();
+    const std::vector<std::string> names{"brickpattern.png", "doorpattern.png", "purplestone.png", "greystone.png", "wood.png"};
+    // memory of the loaded textures, counted from copies
+    const auto usage = [&] {
+        size_t sum = 0;
+        for (const auto& name : names) {
+            if (!texMng.isLoaded(texMng.getHandle(name)))
+                continue;
+            rc::graphics::image::Texture copy;
+            copy.loadFromFile(name);
+            if (texMng.hasMipmaps())
+                copy.buildMipmaps();
+            if (texMng.hasShadedCopies())
+                copy.buildShadedCopy();
+            sum += copy.memorySize() + sizeof(rc::graphics::image::Texture);
+        }
+        return sum;
+    };
+    texMng.setMipmaps(true);
+    // one large (512x512) texture and a few small ones (64x64)
+    texMng.setMemoryLimit(2 * 512 * 512 * 4);
+    for (size_t frame = 0; frame < 10; ++frame) {
+        texMng.newFrame();
+        texMng.getTexture(names[frame % names.size()]);
+        texMng.getTexture(names[(frame * 3) % names.size()]);
+        EXPECT_EQ(texMng.getMemoryUsage(), usage());
+        EXPECT_LE(texMng.getMemoryUsage(), texMng.getMemoryLimit());
+    }
+    texMng.setShadedCopies(true);
+    EXPECT_EQ(texMng.getMemoryUsage(), usage());
+    texMng.setMipmaps(false);
+    EXPECT_EQ(texMng.getMemoryUsage(), usage());
+    texMng.setShadedCopies(false);
+    EXPECT_EQ(texMng.getMemoryUsage(), usage());
+    texMng.setMemoryLimit(memLimit);
+    texMng.unloadAll();
+    EXPECT_EQ(texMng.getMemoryUsage(), 0);
+}
@@ -0,0 +1,43 @@
+
+#include "graphics/WallSpan.h"
+#include "testHelper.h"
+#include <cmath>
+
+using WallSpan = rc::graphics::WallSpan;
+
+TEST(WallSpan, clipping) {
+    const WallSpan span(-10, 40, 64, 0, 20);
+    EXPECT_FALSE(span.empty());
+    EXPECT_EQ(span.firstRow(), 0);
+    EXPECT_EQ(span.count(), 20);
+    const WallSpan inside(4.5, 10, 64, 0, 20);
+    EXPECT_EQ(inside.firstRow(), 4);
+    EXPECT_EQ(inside.count(), 10);
+    EXPECT_TRUE(WallSpan(30, 10, 64, 0, 20).empty());
+    EXPECT_TRUE(WallSpan(0, 10, 0, 0, 20).empty());
+    EXPECT_TRUE(WallSpan(0, 0, 64, 0, 20).empty());
+}
+
+TEST(WallSpan, sameRowsAsDouble) {
+    // the fixed point stepping gives the rows of the double computation
+    size_t checked = 0;
+    for (size_t textureHeight : {1U, 7U, 64U, 256U, 512U}) {
+        for (double lineLength = 0.75; lineLength < 20000; lineLength *= 1.37) {
+            for (double lineY : {-0.5 * lineLength, -3.25, 0.0, 17.6}) {
+                const WallSpan span(lineY, lineLength, textureHeight, 0, 1080);
+                const double textureIncrement = static_cast<double>(textureHeight) / lineLength;
+                const double beginTex         = std::max(0.0, -lineY * textureIncrement);
+                const auto maxTex             = static_cast<int32_t>(textureHeight) - 1;
+                size_t errors                 = 0;
+                span.forEach([&](size_t pixel, size_t textureRow) {
+                    const int32_t reference = std::min(static_cast<int32_t>(beginTex + static_cast<double>(pixel) * textureIncrement), maxTex);
+                    if (textureRow != static_cast<size_t>(reference))
+                        ++errors;
+                    ++checked;
+                });
+                EXPECT_EQ(errors, 0) << "texture " << textureHeight << " line " << lineY << " + " << lineLength;
+            }
+        }
+    }
+    EXPECT_GT(checked, 100000);
+}
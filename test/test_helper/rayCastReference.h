@@ -0,0 +1,77 @@
+/**
+ * @file rayCastReference.h
+ * @author Silmaen
+ * @date 17/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+
+#include "game/Map.h"
+#include "math/functions.h"
+#include <cmath>
+
+namespace rc::test {
+
+/**
+ * @brief Cast a ray in the 2D space, checking vertical then horizontal grid lines
+ * @param map The map
+ * @param from Starting point
+ * @param direction Ray's direction
+ * @return Hit data
+ *
+ * Former implementation of Map::castRay, kept as reference for regression tests and benchmarks.
+ */
+inline game::Map::rayCastResult castRayTwoPass(const game::Map& map, const game::Map::worldCoordinates& from, const game::Map::worldCoordinates& direction) {
+    using worldCoordinates = game::Map::worldCoordinates;
+    using gridCoordinate   = game::Map::gridCoordinate;
+    const auto cubeSize    = map.getCellSize();
+    // check for vertical line
+    double verticalDistance = -1;
+    worldCoordinates verticalPoint{from};
+    double verticalCellRatio = 0;
+    if (std::abs(direction[0]) > 0.001) {
+        // Intersection with verticals
+        worldCoordinates verticalOffset{};
+        verticalOffset = direction / std::abs(direction[0]);
+        verticalPoint  = from + math::geometry::Vectf{math::sign(direction[0]) * 0.001, 0.0} + verticalOffset * std::abs((static_cast<int32_t>(from[0] / cubeSize) + math::heaviside(direction[0])) * cubeSize - from[0]);
+        verticalOffset *= cubeSize;
+        gridCoordinate verticalCell = map.whichCell(verticalPoint);
+        while (map.isInVisible(verticalCell)) {
+            verticalPoint += verticalOffset;
+            verticalCell = map.whichCell(verticalPoint);
+        }
+        if (map.isIn(verticalCell))
+            verticalDistance = (verticalPoint - from).lengthSQ();
+        verticalCellRatio = std::abs(verticalPoint[1] - (verticalCell[1] + math::heaviside(-direction[0])) * cubeSize);
+    }
+    // check for horizontal line
+    double horizontalDistance = -1;
+    worldCoordinates horizontalPoint{from};
+    double horizontalCellRatio = 0;
+    if (std::abs(direction[1]) > 0.001) {
+        // Intersection with horizontals
+        worldCoordinates horizontalOffset{};
+        horizontalOffset = direction / std::abs(direction[1]);
+        horizontalPoint  = from + math::geometry::Vectf{0.0, math::sign(direction[1]) * 0.001} + horizontalOffset * std::abs((static_cast<int32_t>(from[1] / cubeSize) + math::heaviside(direction[1])) * cubeSize - from[1]);
+        horizontalOffset *= cubeSize;
+        gridCoordinate horizontalCell = map.whichCell(horizontalPoint);
+        while (map.isInVisible(horizontalCell)) {
+            horizontalPoint += horizontalOffset;
+            horizontalCell = map.whichCell(horizontalPoint);
+        }
+        if (map.isIn(horizontalCell))
+            horizontalDistance = (horizontalPoint - from).lengthSQ();
+        horizontalCellRatio = std::abs(horizontalPoint[0] - (horizontalCell[0] + math::heaviside(direction[1])) * cubeSize);
+    }
+    if (verticalDistance < 0)
+        return {std::sqrt(horizontalDistance), horizontalPoint, false, horizontalCellRatio};
+    if (horizontalDistance < 0)
+        return {std::sqrt(verticalDistance), verticalPoint, true, verticalCellRatio};
+    if (horizontalDistance < verticalDistance)
+        return {std::sqrt(horizontalDistance), horizontalPoint, false, horizontalCellRatio};
+    return {std::sqrt(verticalDistance), verticalPoint, true, verticalCellRatio};
+}
+
+}// namespace rc::test